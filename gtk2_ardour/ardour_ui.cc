@@ -901,16 +901,6 @@ ARDOUR_UI::~ARDOUR_UI ()
 		/* drop references to any PluginInfoPtr */
 		delete mixer->plugin_selector ();
 	}
-
-
-#ifndef NDEBUG
-	/* Small trick to flush main-thread event pool.
-	 * Other thread-pools are destroyed at pthread_exit(),
-	 * but tmain thread termination is too late to trigger Pool::~Pool()
-	 */
-	SessionEvent* ev = new SessionEvent (SessionEvent::SetTransportSpeed, SessionEvent::Clear, SessionEvent::Immediate, 0, 0); // get the pool reference, values don't matter since the event is never queued.
-	delete ev->event_pool();
-#endif
 }
 
 gint
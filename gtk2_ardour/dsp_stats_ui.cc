@@ -18,6 +18,8 @@
 
 #include <gtkmm/frame.h>
 
+#include "pbd/compose.h"
+
 #include "gtkmm2ext/utils.h"
 
 #include "ardour/session.h"
@@ -39,6 +41,8 @@ using namespace Gtk;
 
 DspStatisticsGUI::DspStatisticsGUI ()
 	: buffer_size_label ("", ALIGN_END, ALIGN_CENTER)
+	, graph_wakeup_label ("", ALIGN_END, ALIGN_CENTER)
+	, event_pool_label ("", ALIGN_END, ALIGN_CENTER)
 	, reset_button (_("Reset"))
 {
 	const size_t nlabels = Session::NTT + AudioEngine::NTT + AudioBackend::NTT;
@@ -80,6 +84,14 @@ DspStatisticsGUI::DspStatisticsGUI ()
 	table.attach (*labels[AudioEngine::NTT + Session::OverallProcess], 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
 	row++;
 
+	table.attach (*manage (new Gtk::Label (_("Graph wake-ups: "), ALIGN_END, ALIGN_CENTER)), 0, 2, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (graph_wakeup_label, 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	row++;
+
+	table.attach (*manage (new Gtk::Label (_("Event pool: "), ALIGN_END, ALIGN_CENTER)), 0, 2, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	table.attach (event_pool_label, 2, 3, row, row+1, Gtk::FILL, Gtk::SHRINK, 2, 0);
+	row++;
+
 	HBox* hbox2 = manage (new HBox);
 	hbox2->pack_start (reset_button, true, true);
 
@@ -286,6 +298,27 @@ DspStatisticsGUI::update ()
 		labels[AudioEngine::NTT + Session::OverallProcess]->set_text (_("No session loaded"));
 		ArdourWidgets::set_tooltip (labels[AudioEngine::NTT + Session::OverallProcess], "");
 	}
+
+	GraphWakeupStats ws;
+	if (_session) {
+		ws = _session->graph_wakeup_stats ();
+	}
+
+	if (ws.spins + ws.sleeps > 0) {
+		/* share of idle process threads that found work while spinning */
+		snprintf (buf, sizeof (buf), _("%5.1f%% spinning"), 100.0 * ws.spins / (double) (ws.spins + ws.sleeps));
+		graph_wakeup_label.set_text (buf);
+		ArdourWidgets::set_tooltip (graph_wakeup_label, string_compose (_("cycles: %1, spinning: %2, sleeping: %3"), ws.cycles, ws.spins, ws.sleeps));
+	} else {
+		graph_wakeup_label.set_text (not_measured_string);
+		ArdourWidgets::set_tooltip (graph_wakeup_label, "");
+	}
+
+	/* the worst case is the largest number of events in use at the same time */
+	PBD::MagazinePool::Stats ps (SessionEvent::pool_stats ());
+	snprintf (buf, sizeof (buf), "%u / %u", ps.high_water, ps.total);
+	event_pool_label.set_text (buf);
+	ArdourWidgets::set_tooltip (event_pool_label, string_compose (_("in use: %1, pool was grown: %2 times, late thread caches: %3"), ps.used, ps.exhausted, ps.lazy_caches));
 }
 
 bool
@@ -45,6 +45,8 @@ private:
 	Gtk::Table table;
 	Gtk::Label buffer_size_label;
 	Gtk::Label** labels;
+	Gtk::Label graph_wakeup_label;
+	Gtk::Label event_pool_label;
 	Gtk::Button reset_button;
 	Gtk::Label info_text;
 
@@ -22,13 +22,18 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <atomic>
 #include <iostream>
 #include <cstdlib>
 #include <cmath>
 #include <ctime>
 #include <string>
 #include <set>
+#include <vector>
 
+#include <glibmm/threads.h>
+
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/memento_command.h"
@@ -40,6 +45,7 @@
 #include "ardour/region.h"
 #include "ardour/region_factory.h"
 #include "ardour/session.h"
+#include "ardour/session_event.h"
 #include "ardour/stretch.h"
 
 #include <gtkmm2ext/utils.h>
@@ -316,6 +322,7 @@ Editor::time_fx (RegionList& regions, Temporal::ratio_t ratio, bool pitching, bo
 #endif
 
 	current_timefx->request.opts = (int) options;
+	current_timefx->request.segment_length = current_timefx->segment_button.get_active () ? 30 * _session->sample_rate () : 0;
 #else
 	current_timefx->request.quick_seek = current_timefx->quick_button.get_active();
 	current_timefx->request.antialias = !current_timefx->antialias_button.get_active();
@@ -360,62 +367,153 @@ Editor::time_fx (RegionList& regions, Temporal::ratio_t ratio, bool pitching, bo
 	return current_timefx->status;
 }
 
-void
-Editor::do_timefx (bool fixed_end)
+namespace {
+
+struct TimeFXJobs {
+	TimeFXJobs (Session& s, TimeFXDialog& d)
+		: session (s)
+		, dialog (d)
+		, next (0)
+	{}
+
+	/** Combine the progress of all regions into TimeFXRequest::progress.
+	 * This is called concurrently by all worker threads.
+	 */
+	void set_progress (size_t n, float p)
+	{
+		Glib::Threads::Mutex::Lock lm (progress_lock);
+		progress[n] = p;
+		float sum = 0;
+		for (std::vector<float>::const_iterator i = progress.begin (); i != progress.end (); ++i) {
+			sum += *i;
+		}
+		dialog.request.progress = sum / progress.size ();
+	}
+
+	Session&                                  session;
+	TimeFXDialog&                             dialog;
+	std::vector<std::shared_ptr<AudioRegion>> regions;
+	std::vector<std::shared_ptr<Region>>      results;
+	std::vector<float>                        progress;
+	Glib::Threads::Mutex                      progress_lock;
+	std::atomic<size_t>                       next;
+};
+
+/** Progress of a single region, reported to TimeFXJobs */
+class TimeFXRegionProgress : public PBD::Progress
 {
-	typedef std::map<std::shared_ptr<Region>, std::shared_ptr<Region> > ResultMap;
-	ResultMap results;
+public:
+	TimeFXRegionProgress (TimeFXJobs& j, size_t n)
+		: _jobs (j)
+		, _n (n)
+	{}
+
+private:
+	void set_overall_progress (float p)
+	{
+		_jobs.set_progress (_n, p);
+	}
 
-	uint32_t const N = current_timefx->regions.size ();
+	TimeFXJobs& _jobs;
+	size_t      _n;
+};
 
-	for (RegionList::const_iterator i = current_timefx->regions.begin(); i != current_timefx->regions.end(); ++i) {
+}
 
-		std::shared_ptr<AudioRegion> region = std::dynamic_pointer_cast<AudioRegion> (*i);
-		std::shared_ptr<Playlist> playlist;
+static void
+timefx_worker (TimeFXJobs* jobs)
+{
+	SessionEvent::create_per_thread_pool ("timefx events", 64);
+	Temporal::TempoMap::fetch ();
 
-		if (!region || (playlist = region->playlist()) == 0) {
-			continue;
-		}
+	TimeFXDialog& dialog (jobs->dialog);
 
-		if (current_timefx->request.cancel) {
-			break;
-		}
+	size_t n;
+	while ((n = jobs->next.fetch_add (1)) < jobs->regions.size () && !dialog.request.cancel) {
 
 		Filter* fx;
 
-		if (current_timefx->pitching) {
-			fx = new Pitch (*_session, current_timefx->request);
+		if (dialog.pitching) {
+			fx = new Pitch (jobs->session, dialog.request);
 		} else {
 #ifdef USE_RUBBERBAND
 		#ifdef HAVE_SOUNDTOUCH
-			if (current_timefx->request.use_soundtouch) {
-				fx = new STStretch (*_session, current_timefx->request);
+			if (dialog.request.use_soundtouch) {
+				fx = new STStretch (jobs->session, dialog.request);
 			} else {
-				fx = new RBStretch (*_session, current_timefx->request);
+				fx = new RBStretch (jobs->session, dialog.request);
 			}
 		#else
-			fx = new RBStretch (*_session, current_timefx->request);
+			fx = new RBStretch (jobs->session, dialog.request);
 		#endif
 #else
-			fx = new STStretch (*_session, current_timefx->request);
+			fx = new STStretch (jobs->session, dialog.request);
 #endif
 		}
 
-		current_timefx->descend (1.0 / N);
+		TimeFXRegionProgress progress (*jobs, n);
 
-		if (fx->run (region, current_timefx)) {
-			current_timefx->request.cancel = true;
+		if (fx->run (jobs->regions[n], &progress)) {
+			dialog.request.cancel = true;
 			delete fx;
 			break;
 		}
 
 		if (!fx->results.empty()) {
-			results[region] = fx->results.front();
+			jobs->results[n] = fx->results.front();
 		}
 
-		current_timefx->ascend ();
 		delete fx;
 	}
+}
+
+void
+Editor::do_timefx (bool fixed_end)
+{
+	typedef std::map<std::shared_ptr<Region>, std::shared_ptr<Region> > ResultMap;
+	ResultMap results;
+
+	TimeFXJobs jobs (*_session, *current_timefx);
+
+	for (RegionList::const_iterator i = current_timefx->regions.begin(); i != current_timefx->regions.end(); ++i) {
+
+		std::shared_ptr<AudioRegion> region = std::dynamic_pointer_cast<AudioRegion> (*i);
+
+		if (!region || region->playlist() == 0) {
+			continue;
+		}
+
+		jobs.regions.push_back (region);
+	}
+
+	jobs.results.resize (jobs.regions.size ());
+	jobs.progress.resize (jobs.regions.size (), 0.f);
+	current_timefx->request.progress = 0;
+
+	/* Process regions concurrently. When splitting regions into
+	 * segments, each region already uses all available cores.
+	 */
+	size_t n_workers = current_timefx->request.segment_length > 0 ? 1 : hardware_concurrency ();
+	n_workers = std::max<size_t> (1, std::min (n_workers, jobs.regions.size ()));
+
+	std::vector<PBD::Thread*> workers;
+	for (size_t i = 1; i < n_workers; ++i) {
+		workers.push_back (PBD::Thread::create (boost::bind (&timefx_worker, &jobs), string_compose ("timefx %1", i)));
+	}
+
+	/* this thread is a worker, too */
+	timefx_worker (&jobs);
+
+	for (std::vector<PBD::Thread*>::const_iterator i = workers.begin (); i != workers.end (); ++i) {
+		(*i)->join ();
+		delete *i;
+	}
+
+	for (size_t i = 0; i < jobs.regions.size (); ++i) {
+		if (jobs.results[i]) {
+			results[jobs.regions[i]] = jobs.results[i];
+		}
+	}
 
 	pthread_setcancelstate (PTHREAD_CANCEL_DISABLE, NULL);
 	if (current_timefx->request.cancel) {
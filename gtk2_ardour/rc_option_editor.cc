@@ -4782,6 +4782,30 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+#if !(defined PLATFORM_WINDOWS || defined __APPLE__)
+		bo = new BoolOption (
+				"pin-process-threads",
+				_("Keep process threads close to the audio engine's thread"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_pin_process_threads),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_pin_process_threads)
+				);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When enabled, process threads are restricted to CPUs that share a cache (or else a memory node) with the audio engine's process thread. This can reduce cache misses on systems with many CPU cores."));
+		bo->set_note (_("This setting will only take effect when the audio engine is restarted."));
+		add_option (_("Performance"), bo);
+
+		bo = new BoolOption (
+				"process-threads-avoid-smt",
+				_("Do not use hyper-threads for process threads"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_process_threads_avoid_smt),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_process_threads_avoid_smt)
+				);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When process threads are kept close to the audio engine's thread, only use one hardware thread of every CPU core."));
+		bo->set_note (_("This setting will only take effect when the audio engine is restarted."));
+		add_option (_("Performance"), bo);
+#endif
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
@@ -1395,6 +1395,7 @@ RecorderUI::InputPort::InputPort (string const& name, DataType dt, RecorderUI* p
 	, _add_button ("+")
 	, _port_name (name)
 	, _ioplug (ioplug)
+	, _subscribed (false)
 	, _solo_release (0)
 {
 	if (!_size_groups_initialized) {
@@ -1506,9 +1507,33 @@ RecorderUI::InputPort::InputPort (string const& name, DataType dt, RecorderUI* p
 
 RecorderUI::InputPort::~InputPort ()
 {
+	if (_subscribed) {
+		AudioEngine::instance ()->unsubscribe_input_meter (_port_name);
+	}
 	delete _solo_release;
 }
 
+void
+RecorderUI::InputPort::on_map ()
+{
+	EventBox::on_map ();
+	/* I/O plugins meter their ports themselves */
+	if (!_ioplug && !_subscribed) {
+		AudioEngine::instance ()->subscribe_input_meter (_port_name);
+		_subscribed = true;
+	}
+}
+
+void
+RecorderUI::InputPort::on_unmap ()
+{
+	if (_subscribed) {
+		AudioEngine::instance ()->unsubscribe_input_meter (_port_name);
+		_subscribed = false;
+	}
+	EventBox::on_unmap ();
+}
+
 void
 RecorderUI::InputPort::clear ()
 {
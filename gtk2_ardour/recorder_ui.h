@@ -224,6 +224,10 @@ private:
 				return _dt < (uint32_t) o._dt;
 			}
 
+		protected:
+			void on_map ();
+			void on_unmap ();
+
 		private:
 			void rename_port ();
 			bool monitor_press (GdkEventButton*);
@@ -240,6 +244,7 @@ private:
 			ArdourWidgets::ArdourButton _add_button;
 			std::string                 _port_name;
 			bool                        _ioplug;
+			bool                        _subscribed;
 			ARDOUR::WeakRouteList       _connected_routes;
 			ARDOUR::SoloMuteRelease*    _solo_release;
 
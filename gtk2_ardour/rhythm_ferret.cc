@@ -26,7 +26,9 @@
 #include "pbd/memento_command.h"
 #include "pbd/convert.h"
 
+#include "ardour/analyser.h"
 #include "ardour/audioregion.h"
+#include "ardour/audiosource.h"
 #include "ardour/onset_detector.h"
 #include "ardour/session.h"
 #include "ardour/transient_detector.h"
@@ -261,6 +263,41 @@ RhythmFerret::run_analysis ()
 	}
 }
 
+/** Use cached results of a previous analysis of the given region-channel's
+ * source with identical settings. Results are translated to be relative to
+ * the region's start, as if the region had been analysed.
+ *
+ * If there are no cached results yet, the complete source is queued for
+ * analysis in the background, and only the region itself is analysed now.
+ */
+template <typename Detector> static int
+run_cached_source_analysis (Detector& t, Analyser::AnalysisFunctor const& source_analysis, std::shared_ptr<AudioReadable> readable, uint32_t chn, AnalysisFeatureList& results)
+{
+	std::shared_ptr<AudioRegion> ar = std::dynamic_pointer_cast<AudioRegion> (readable);
+	if (!ar || chn >= ar->n_channels ()) {
+		return t.run ("", readable.get(), chn, results);
+	}
+
+	std::shared_ptr<AudioSource> src = ar->audio_source (chn);
+	std::string const key = t.analysis_key ();
+	AnalysisFeatureList all;
+
+	if (Analyser::load_analysis (src, key, all)) {
+		Analyser::queue_source_for_analysis (src, key, source_analysis);
+		return t.run ("", readable.get(), chn, results);
+	}
+
+	samplepos_t const start = ar->start_sample ();
+	samplepos_t const end   = start + ar->length_samples ();
+
+	for (AnalysisFeatureList::const_iterator i = all.begin(); i != all.end(); ++i) {
+		if (*i >= start && *i < end) {
+			results.push_back (*i - start);
+		}
+	}
+	return 0;
+}
+
 int
 RhythmFerret::run_percussion_onset_analysis (std::shared_ptr<AudioReadable> readable, sampleoffset_t /*offset*/, AnalysisFeatureList& results)
 {
@@ -274,10 +311,20 @@ RhythmFerret::run_percussion_onset_analysis (std::shared_ptr<AudioReadable> read
 			t.reset ();
 			float dB = detection_threshold_adjustment.get_value();
 			float coeff = dB > -80.0f ? pow (10.0f, dB * 0.05f) : 0.0f;
+			float sensitivity = sensitivity_adjustment.get_value();
 			t.set_threshold (coeff);
-			t.set_sensitivity (4, sensitivity_adjustment.get_value());
-
-			if (t.run ("", readable.get(), i, these_results)) {
+			t.set_sensitivity (4, sensitivity);
+
+			/* background analysis of the whole source, using the same settings */
+			float const sr = _session->sample_rate();
+			Analyser::AnalysisFunctor source_analysis = [sr, coeff, sensitivity] (AudioReadable* src, AnalysisFeatureList& all) {
+				TransientDetector td (sr);
+				td.set_threshold (coeff);
+				td.set_sensitivity (4, sensitivity);
+				return td.run ("", src, 0, all);
+			};
+
+			if (run_cached_source_analysis (t, source_analysis, readable, i, these_results)) {
 				continue;
 			}
 
@@ -326,17 +373,34 @@ RhythmFerret::run_note_onset_analysis (std::shared_ptr<AudioReadable> readable,
 
 			AnalysisFeatureList these_results;
 
-			t.set_function (get_note_onset_function());
-			t.set_silence_threshold (silence_threshold_adjustment.get_value());
-			t.set_peak_threshold (peak_picker_threshold_adjustment.get_value());
+			int   function          = get_note_onset_function();
+			float silence_threshold = silence_threshold_adjustment.get_value();
+			float peak_threshold    = peak_picker_threshold_adjustment.get_value();
+			float minioi            = minioi_adjustment.get_value();
+
+			t.set_function (function);
+			t.set_silence_threshold (silence_threshold);
+			t.set_peak_threshold (peak_threshold);
 #ifdef HAVE_AUBIO4
-			t.set_minioi (minioi_adjustment.get_value());
+			t.set_minioi (minioi);
 #endif
 
 			// aubio-vamp only picks up new settings on reset.
 			t.reset ();
 
-			if (t.run ("", readable.get(), i, these_results)) {
+			/* background analysis of the whole source, using the same settings */
+			float const sr = _session->sample_rate();
+			Analyser::AnalysisFunctor source_analysis = [sr, function, silence_threshold, peak_threshold, minioi] (AudioReadable* src, AnalysisFeatureList& all) {
+				OnsetDetector od (sr);
+				od.set_function (function);
+				od.set_silence_threshold (silence_threshold);
+				od.set_peak_threshold (peak_threshold);
+				od.set_minioi (minioi);
+				od.reset ();
+				return od.run ("", src, 0, all);
+			};
+
+			if (run_cached_source_analysis (t, source_analysis, readable, i, these_results)) {
 				continue;
 			}
 
@@ -427,6 +427,23 @@ SessionOptionEditor::SessionOptionEditor (Session* s)
 	add_option (_("Misc"), 	bo);
 #endif
 
+	add_option (_("Misc"), new OptionEditorHeading (_("Processing")));
+
+	SpinOption<uint32_t>* spo = new SpinOption<uint32_t> (
+		"graph-worker-spin-usecs",
+		_("Idle process threads wait for work (usec)"),
+		sigc::mem_fun (*_session_config, &SessionConfiguration::get_graph_worker_spin_usecs),
+		sigc::mem_fun (*_session_config, &SessionConfiguration::set_graph_worker_spin_usecs),
+		0, 1000, 5, 50
+		);
+
+	Gtkmm2ext::UI::instance()->set_tip (spo->tip_widget(),
+	                                    _("Idle process threads briefly spin before they go to sleep. "
+	                                      "This reduces the latency of waking them up, at the cost of CPU time. "
+	                                      "When set to zero, idle threads always sleep. "
+	                                      "The Performance Meters window shows how often threads found work while spinning."));
+	add_option (_("Misc"), spo);
+
 	add_option (_("Misc"), new OptionEditorHeading (_("Metronome")));
 
 	add_option (_("Misc"), new BoolOption (
@@ -34,6 +34,8 @@
 
 #include "gtkmm2ext/utils.h"
 
+#include "widgets/tooltips.h"
+
 #include "audio_clock.h"
 #include "editor.h"
 #include "audio_time_axis.h"
@@ -64,6 +66,7 @@ TimeFXDialog::TimeFXDialog (Editor& e, bool pitch, timecnt_t const & oldlen, tim
 	, stretch_opts_label (_("Contents"))
 	, precise_button (_("Minimize time distortion"))
 	, preserve_formants_button(_("Preserve Formants"))
+	, segment_button (_("Process long regions in parallel segments"))
 	, fixed_end (fixed_end)
 	, original_length (oldlen)
 	, pitch_octave_adjustment (0.0, -4.0, 4.0, 1, 2.0)
@@ -77,7 +80,6 @@ TimeFXDialog::TimeFXDialog (Editor& e, bool pitch, timecnt_t const & oldlen, tim
 	, duration_clock (0)
 	, ignore_adjustment_change (false)
 	, ignore_clock_change (false)
-	, progress (0.0f)
 {
 	set_modal (true);
 	set_skip_taskbar_hint (true);
@@ -186,6 +188,10 @@ TimeFXDialog::TimeFXDialog (Editor& e, bool pitch, timecnt_t const & oldlen, tim
 		table->attach (precise_button, 0, 2, row, row+1, Gtk::FILL, Gtk::EXPAND, 0, 0);
 		row++;
 
+		ArdourWidgets::set_tooltip (segment_button, _("Split long regions into overlapping segments which are stretched concurrently and cross-faded. This is faster on multi-core systems, but may slightly alter the sound at the seams."));
+		table->attach (segment_button, 0, 2, row, row+1, Gtk::FILL, Gtk::EXPAND, 0, 0);
+		row++;
+
 		duration_clock->ValueChanged.connect (sigc::mem_fun (*this, &TimeFXDialog::duration_clock_changed));
 		duration_adjustment.signal_value_changed().connect (sigc::mem_fun (*this, &TimeFXDialog::duration_adjustment_changed));
 
@@ -238,13 +244,13 @@ TimeFXDialog::update_progress_gui (float p)
 	   timer-driven callback which will ensure that the visual progress
 	   indicator is updated.
 	*/
-	progress = p;
+	request.progress = p;
 }
 
 void
 TimeFXDialog::timer_update ()
 {
-	progress_bar.set_fraction (progress);
+	progress_bar.set_fraction (request.progress);
 
 	if (request.done || request.cancel) {
 		update_connection.disconnect ();
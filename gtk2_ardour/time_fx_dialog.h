@@ -60,6 +60,7 @@ public:
 	Gtk::Label            stretch_opts_label;
 	Gtk::CheckButton      precise_button;
 	Gtk::CheckButton      preserve_formants_button;
+	Gtk::CheckButton      segment_button;
 
 	Gtk::Button*          cancel_button;
 	Gtk::Button*          action_button;
@@ -100,7 +101,6 @@ private:
 	bool                ignore_adjustment_change;
 	bool                ignore_clock_change;
 	sigc::connection    update_connection;
-	float               progress;
 
 	void update_progress_gui (float);
 	void duration_clock_changed ();
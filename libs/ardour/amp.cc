@@ -46,6 +46,8 @@ Amp::Amp (Session& s, const std::string& name, std::shared_ptr<GainControl> gc,
 	: Processor(s, "Amp", Temporal::TimeDomainProvider (Temporal::AudioTime))
 	, _apply_gain_automation(false)
 	, _current_gain(GAIN_COEFF_ZERO)
+	, _stage_current(GAIN_COEFF_UNITY)
+	, _stage_target(GAIN_COEFF_UNITY)
 	, _current_automation_sample (INT64_MAX)
 	, _gain_control (gc)
 	, _gain_automation_buffer(0)
@@ -152,6 +154,60 @@ Amp::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end_sampl
 	}
 }
 
+bool
+Amp::setup_gain_stage (BufferSet const& bufs)
+{
+	if (!check_active()) {
+		_apply_gain_automation = false;
+		return true;
+	}
+
+	if (_apply_gain_automation || (_midi_amp && bufs.count().n_midi() > 0)) {
+		return false;
+	}
+
+	_stage_target = _gain_control->get_value();
+
+	if (fabsf (_current_gain - _stage_target) < GAIN_COEFF_DELTA) {
+		_current_gain = _stage_target;
+	}
+	_stage_current = _current_gain;
+	return true;
+}
+
+void
+Amp::gain_stage (uint32_t, gain_t& current, gain_t& target) const
+{
+	if (!_active) {
+		current = target = GAIN_COEFF_UNITY;
+	} else {
+		current = _stage_current;
+		target  = _stage_target;
+	}
+}
+
+void
+Amp::set_gain_stage (uint32_t chn, gain_t current)
+{
+	/* all channels share the same gain */
+	if (!_active || chn > 0) {
+		return;
+	}
+
+	if (_stage_current == _stage_target) {
+		return;
+	}
+
+	if (fabsf (current - _stage_target) < GAIN_COEFF_DELTA) {
+		_current_gain = _stage_target;
+	} else {
+		_current_gain = current;
+	}
+
+	/* see Amp::run */
+	_gain_control->Changed (false, PBD::Controllable::NoGroup);
+}
+
 gain_t
 Amp::apply_gain (BufferSet& bufs, samplecnt_t sample_rate, samplecnt_t nframes, gain_t initial, gain_t target, bool midi_amp)
 {
@@ -19,6 +19,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <fstream>
+
 #include "ardour/analyser.h"
 #include "ardour/audiofilesource.h"
 #include "ardour/rc_configuration.h"
@@ -26,7 +28,9 @@
 #include "ardour/transient_detector.h"
 
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
+#include "pbd/gstdio_compat.h"
 
 #include "pbd/i18n.h"
 
@@ -34,12 +38,12 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
-Glib::Threads::Mutex          Analyser::analysis_active_lock;
+Glib::Threads::RWLock         Analyser::analysis_active_lock;
 Glib::Threads::Mutex          Analyser::analysis_queue_lock;
 Glib::Threads::Cond           Analyser::SourcesToAnalyse;
-list<std::weak_ptr<Source>> Analyser::analysis_queue;
+list<Analyser::AnalysisJob>   Analyser::analysis_queue;
 bool                          Analyser::analysis_thread_run = false;
-PBD::Thread*                  Analyser::analysis_thread     = 0;
+vector<PBD::Thread*>          Analyser::analysis_threads;
 
 Analyser::Analyser ()
 {
@@ -52,7 +56,14 @@ Analyser::init ()
 		return;
 	}
 	analysis_thread_run = true;
-	analysis_thread     = PBD::Thread::create (sigc::ptr_fun (&Analyser::work), "Analyzer");
+
+	/* Analysis is I/O and CPU bound. Use a few threads,
+	 * but leave room for the GUI and butler.
+	 */
+	uint32_t n_threads = std::max<uint32_t> (1, std::min<uint32_t> (4, hardware_concurrency () / 2));
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		analysis_threads.push_back (PBD::Thread::create (sigc::ptr_fun (&Analyser::work), string_compose ("Analyzer %1", i)));
+	}
 }
 
 void
@@ -63,7 +74,10 @@ Analyser::terminate ()
 	}
 	analysis_thread_run = false;
 	SourcesToAnalyse.broadcast ();
-	analysis_thread->join ();
+	for (vector<PBD::Thread*>::const_iterator i = analysis_threads.begin (); i != analysis_threads.end (); ++i) {
+		(*i)->join ();
+	}
+	analysis_threads.clear ();
 }
 
 void
@@ -77,9 +91,25 @@ Analyser::queue_source_for_analysis (std::shared_ptr<Source> src, bool force)
 		return;
 	}
 
+	queue_source_for_analysis (src, "", AnalysisFunctor ());
+}
+
+void
+Analyser::queue_source_for_analysis (std::shared_ptr<Source> src, string const& key, AnalysisFunctor analyse)
+{
+	if (!src->can_be_analysed ()) {
+		return;
+	}
+
 	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
-	analysis_queue.push_back (std::weak_ptr<Source> (src));
-	SourcesToAnalyse.broadcast ();
+	for (list<AnalysisJob>::const_iterator i = analysis_queue.begin (); i != analysis_queue.end (); ++i) {
+		if (i->key == key && i->source.lock () == src) {
+			/* already queued */
+			return;
+		}
+	}
+	analysis_queue.push_back (AnalysisJob (src, key, analyse));
+	SourcesToAnalyse.signal ();
 }
 
 void
@@ -104,15 +134,19 @@ Analyser::work ()
 			goto wait;
 		}
 
-		std::shared_ptr<Source> src (analysis_queue.front ().lock ());
+		AnalysisJob job (analysis_queue.front ());
 		analysis_queue.pop_front ();
 		analysis_queue_lock.unlock ();
 
-		std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (src);
+		std::shared_ptr<AudioFileSource> afs = std::dynamic_pointer_cast<AudioFileSource> (job.source.lock ());
 
 		if (afs && !afs->empty ()) {
-			Glib::Threads::Mutex::Lock lm (analysis_active_lock);
-			analyse_audio_file_source (afs);
+			Glib::Threads::RWLock::ReaderLock lm (analysis_active_lock);
+			if (job.analyse) {
+				run_analysis_job (afs, job);
+			} else {
+				analyse_audio_file_source (afs);
+			}
 		}
 	}
 }
@@ -138,10 +172,79 @@ Analyser::analyse_audio_file_source (std::shared_ptr<AudioFileSource> src)
 	}
 }
 
+void
+Analyser::run_analysis_job (std::shared_ptr<AudioFileSource> src, AnalysisJob const& job)
+{
+	AnalysisFeatureList results;
+
+	if (load_analysis (src, job.key, results) == 0) {
+		/* analysed since the job was queued */
+		return;
+	}
+
+	try {
+		if (job.analyse (src.get (), results)) {
+			return;
+		}
+	} catch (...) {
+		error << string_compose (_ ("Analysis failed for %1."), src->name ()) << endmsg;
+		return;
+	}
+
+	save_analysis (src, job.key, results);
+}
+
 void
 Analyser::flush ()
 {
 	Glib::Threads::Mutex::Lock lq (analysis_queue_lock);
-	Glib::Threads::Mutex::Lock la (analysis_active_lock);
+	Glib::Threads::RWLock::WriterLock la (analysis_active_lock);
 	analysis_queue.clear ();
 }
+
+int
+Analyser::load_analysis (std::shared_ptr<Source> src, string const& key, AnalysisFeatureList& results)
+{
+	ifstream f (src->get_analysis_path (key).c_str ());
+	if (!f) {
+		return -1;
+	}
+
+	AnalysisFeatureList rv;
+	samplepos_t         pos;
+	while (f >> pos) {
+		rv.push_back (pos);
+	}
+
+	if (!f.eof ()) {
+		return -1;
+	}
+
+	results.swap (rv);
+	return 0;
+}
+
+int
+Analyser::save_analysis (std::shared_ptr<Source> src, string const& key, AnalysisFeatureList const& results)
+{
+	string const path = src->get_analysis_path (key);
+	string const tmp  = path + ".tmp";
+
+	{
+		ofstream f (tmp.c_str ());
+		for (AnalysisFeatureList::const_iterator i = results.begin (); i != results.end (); ++i) {
+			f << *i << endl;
+		}
+		if (!f) {
+			::g_unlink (tmp.c_str ());
+			return -1;
+		}
+	}
+
+	/* other threads may concurrently load the same analysis */
+	if (::g_rename (tmp.c_str (), path.c_str ())) {
+		::g_unlink (tmp.c_str ());
+		return -1;
+	}
+	return 0;
+}
@@ -26,6 +26,7 @@
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/chan_count.h"
+#include "ardour/gain_stage.h"
 #include "ardour/processor.h"
 #include "ardour/automation_control.h"
 
@@ -36,7 +37,7 @@ class GainControl;
 class IO;
 
 /** Gain Stage (Fader, Trim).  */
-class LIBARDOUR_API Amp : public Processor {
+class LIBARDOUR_API Amp : public Processor, public GainStage {
 public:
 	Amp(Session& s, const std::string& display_name, std::shared_ptr<GainControl> control, bool control_midi_also);
 
@@ -50,6 +51,10 @@ public:
 
 	void run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_sample, double speed, pframes_t nframes, bool);
 
+	bool setup_gain_stage (BufferSet const&);
+	void gain_stage (uint32_t chn, gain_t& current, gain_t& target) const;
+	void set_gain_stage (uint32_t chn, gain_t current);
+
 	void set_gain_automation_buffer (gain_t *);
 
 	void setup_gain_automation (samplepos_t start_sample, samplepos_t end_sample, samplecnt_t nframes);
@@ -74,6 +79,8 @@ public:
 private:
 	bool   _apply_gain_automation;
 	float  _current_gain;
+	gain_t _stage_current;
+	gain_t _stage_target;
 	samplepos_t _current_automation_sample;
 
 	std::string _display_name;
@@ -21,13 +21,19 @@
 #define __ardour_analyser_h__
 
 #include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/function.hpp>
 
 #include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
 #include "pbd/pthread_utils.h"
 
 namespace ARDOUR
 {
 class AudioFileSource;
+class AudioReadable;
 class Source;
 
 class LIBARDOUR_API Analyser
@@ -37,19 +43,48 @@ public:
 
 	static void init ();
 	static void terminate ();
+	/** Analyse a source of the given type, identified by key
+	 * (see AudioAnalyser::analysis_key). The functor is called in an
+	 * Analyser thread to analyse the complete source, it must not
+	 * reference any GUI state. On success the result is stored with
+	 * save_analysis, and can later be retrieved with load_analysis.
+	 */
+	typedef boost::function<int (AudioReadable*, AnalysisFeatureList&)> AnalysisFunctor;
+
 	static void queue_source_for_analysis (std::shared_ptr<Source>, bool force);
+	static void queue_source_for_analysis (std::shared_ptr<Source>, std::string const& key, AnalysisFunctor);
 	static void work ();
 	static void flush ();
 
+	/* Persistent analysis results, stored in the session's analysis
+	 * folder. The key identifies the analysis and its parameters
+	 * (see AudioAnalyser::analysis_key). Both return 0 on success.
+	 */
+	static int load_analysis (std::shared_ptr<Source>, std::string const& key, AnalysisFeatureList&);
+	static int save_analysis (std::shared_ptr<Source>, std::string const& key, AnalysisFeatureList const&);
+
 private:
-	static Glib::Threads::Mutex               analysis_active_lock;
+	struct AnalysisJob {
+		AnalysisJob (std::shared_ptr<Source> s, std::string const& k, AnalysisFunctor f)
+			: source (s)
+			, key (k)
+			, analyse (f)
+		{}
+
+		std::weak_ptr<Source> source;
+		std::string           key; ///< empty for transient analysis
+		AnalysisFunctor       analyse;
+	};
+
+	static Glib::Threads::RWLock              analysis_active_lock;
 	static Glib::Threads::Mutex               analysis_queue_lock;
 	static Glib::Threads::Cond                SourcesToAnalyse;
-	static std::list<std::weak_ptr<Source>> analysis_queue;
+	static std::list<AnalysisJob>             analysis_queue;
 	static bool                               analysis_thread_run;
-	static PBD::Thread*                       analysis_thread;
+	static std::vector<PBD::Thread*>          analysis_threads;
 
 	static void analyse_audio_file_source (std::shared_ptr<AudioFileSource>);
+	static void run_analysis_job (std::shared_ptr<AudioFileSource>, AnalysisJob const&);
 };
 
 } // namespace ARDOUR
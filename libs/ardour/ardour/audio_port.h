@@ -22,8 +22,6 @@
 #ifndef __ardour_audio_port_h__
 #define __ardour_audio_port_h__
 
-#include "zita-resampler/vmresampler.h"
-
 #include "ardour/port.h"
 #include "ardour/audio_buffer.h"
 
@@ -63,8 +61,11 @@ protected:
 	Sample* engine_get_whole_audio_buffer ();
 
 private:
+	void alloc_src_buffer ();
+
 	AudioBuffer*            _buffer;
-	ArdourZita::VMResampler _src;
+	Sample*                 _src_buf;   // resampler history, see PortManager::port_resampler
+	bool                    _src_stale;
 	Sample*                 _data;
 	bool                    _buf_valid;
 };
@@ -51,6 +51,12 @@ class LIBARDOUR_API AudioAnalyser : public boost::noncopyable {
 
 	void reset ();
 
+	/** Identify the analysis by plugin, sample-rate and current parameter values.
+	 * The returned string is suitable as file-name component, and used
+	 * as key for cached analysis results (see Analyser::load_analysis).
+	 */
+	std::string analysis_key () const;
+
   protected:
 	float sample_rate;
 	AnalysisPlugin* plugin;
@@ -20,6 +20,7 @@
 #define __libardour_buffer_manager__
 
 #include <stdint.h>
+#include <vector>
 
 #include "pbd/ringbufferNPT.h"
 
@@ -36,11 +37,16 @@ class LIBARDOUR_API BufferManager
 public:
 	static void init (uint32_t);
 
-	static ThreadBuffers* get_thread_buffers ();
+	static ThreadBuffers* get_thread_buffers (bool local = false);
 	static void           put_thread_buffers (ThreadBuffers*);
 
 	static void ensure_buffers (ChanCount howmany = ChanCount::ZERO, size_t custom = 0);
 
+	/* memory node of the calling thread, only known on systems with
+	 * more than one memory node.
+	 */
+	static int current_numa_node ();
+
 private:
         static Glib::Threads::Mutex rb_mutex;
 
@@ -49,6 +55,8 @@ private:
 
 	static ThreadBufferFIFO* thread_buffers;
 	static ThreadBufferList* thread_buffers_list;
+
+	static std::vector<int> cpu_numa_node;
 };
 
 }
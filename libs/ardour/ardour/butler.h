@@ -41,10 +41,8 @@
 namespace ARDOUR
 {
 /**
- *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
- *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
- *  When the Butler thread wakes up, we check this trash buffer for CTPs, and if they
- *  are empty they are deleted.
+ *  One of the Butler's functions is to refill the SessionEvent pool, so that
+ *  realtime threads do not have to allocate memory when queueing events.
  */
 
 class LIBARDOUR_API Butler : public SessionHandleRef
@@ -98,7 +96,6 @@ private:
 
 	void* thread_work ();
 
-	void empty_pool_trash ();
 	void process_delegated_work ();
 	void config_changed (std::string);
 	bool flush_tracks_to_disk_normal (std::shared_ptr<RouteList const>, uint32_t& errors);
@@ -115,7 +112,6 @@ private:
 	samplecnt_t _audio_playback_buffer_size;
 	uint32_t    _midi_buffer_size;
 
-	PBD::RingBuffer<PBD::CrossThreadPool*> pool_trash;
 	CrossThreadChannel                    _xthread;
 	PBD::MPMCQueue<sigc::slot<void> >     _delegated_work;
 };
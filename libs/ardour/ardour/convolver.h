@@ -18,6 +18,7 @@
 #ifndef _ardour_convolver_h_
 #define _ardour_convolver_h_
 
+#include <memory>
 #include <vector>
 
 #include "zita-convolver/zita-convolver.h"
@@ -34,7 +35,7 @@ class LIBARDOUR_API Convolution : public SessionHandleRef
 {
 public:
 	Convolution (Session&, uint32_t n_in, uint32_t n_out);
-	virtual ~Convolution () {}
+	virtual ~Convolution ();
 
 	bool add_impdata (
 	    uint32_t                    c_in,
@@ -53,6 +54,21 @@ public:
 
 	void clear_impdata ();
 	void restart ();
+
+	/** Set the partition sizes of the non-uniform partitioned convolution.
+	 * This takes effect with the next call to restart ().
+	 *
+	 * @param min_part smallest partition size, 0: use the processing quantum
+	 * @param max_part largest partition size, 0: Convproc::MAXPART (or the quantum if not threaded)
+	 * @param density density of the in/out matrix (0..1], 0: auto
+	 */
+	void set_partitioning (uint32_t min_part, uint32_t max_part, float density = 0);
+
+	/** @return number of partitions that were dropped by all instances,
+	 * because the shared worker threads could not keep up.
+	 */
+	static uint32_t scheduler_overruns ();
+
 	void run (BufferSet&, ChanMapping const&, ChanMapping const&, pframes_t, samplecnt_t);
 
 	void run_mono_buffered (float*, uint32_t);
@@ -67,7 +83,20 @@ protected:
 	bool     _configured;
 	bool     _threaded;
 
+	/** when set, IR spectra are shared with other instances using the same key */
+	std::string _ir_key;
+
 private:
+	int create_impdata (ArdourZita::Convproc&);
+	int share_impdata (uint32_t min_part, uint32_t max_part);
+
+	uint32_t _min_part;
+	uint32_t _max_part;
+	float    _density;
+
+	std::shared_ptr<ArdourZita::Convproc> _shared_ir;
+	ArdourZita::Convsched*                _sched;
+
 	class ImpData : public AudioReadable
 	{
 	public:
@@ -53,7 +53,7 @@ public:
 	std::string format_name () const { return _format_name; }
 
 private:
-	void start_ffmpeg ();
+	void start_ffmpeg (samplepos_t start = 0);
 	void reset ();
 
 	void did_read_data (std::string data, size_t size);
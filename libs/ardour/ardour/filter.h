@@ -22,6 +22,8 @@
 
 #include <vector>
 
+#include <glibmm/threads.h>
+
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 
@@ -49,6 +51,10 @@ class LIBARDOUR_API Filter {
 	int finish (std::shared_ptr<ARDOUR::Region>, ARDOUR::SourceList&, std::string region_name = "");
 
 	ARDOUR::Session& session;
+
+  private:
+	/* filters may run concurrently, serialize creating sources and regions */
+	static Glib::Threads::Mutex _source_lock;
 };
 
 } /* namespace */
@@ -0,0 +1,55 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_gain_stage_h__
+#define __ardour_gain_stage_h__
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class BufferSet;
+
+/** A processor that only applies a de-zippered linear gain to each
+ * audio channel (Amp, PolarityProcessor).
+ *
+ * Consecutive gain stages can be applied in a single pass over the
+ * buffers instead of calling ::run() of each, see
+ * Route::run_gain_stages(). All methods are called from the process
+ * thread, instead of ::run().
+ */
+class LIBARDOUR_API GainStage
+{
+public:
+	virtual ~GainStage () {}
+
+	/** Prepare the gain for this cycle.
+	 * @return false if the stage needs to be run normally,
+	 * e.g. because of gain automation or MIDI velocity scaling.
+	 */
+	virtual bool setup_gain_stage (BufferSet const&) = 0;
+
+	/** Query the gain ramp of an audio channel for this cycle */
+	virtual void gain_stage (uint32_t chn, gain_t& current, gain_t& target) const = 0;
+
+	/** Report the gain of an audio channel at the end of this cycle */
+	virtual void set_gain_stage (uint32_t chn, gain_t current) = 0;
+};
+
+} // namespace ARDOUR
+
+#endif // __ardour_gain_stage_h__
@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 
+#include <glibmm/threads.h>
 
 #include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
@@ -94,17 +95,35 @@ public:
 	/* RTTasks */
 	void process_tasklist (RTTaskList const&);
 
+	/* called from a graph node while the graph is running:
+	 * share the tasks with idle worker threads, and return
+	 * once all tasks have completed.
+	 * Returns false if the tasks were not processed, this is
+	 * always the case unless called from one of the graph's threads.
+	 */
+	bool process_nested_tasklist (RTTaskList&);
+
+	GraphWakeupStats wakeup_stats () const;
+	void             reset_wakeup_stats ();
+
 protected:
 	virtual void session_going_away ();
 
 private:
 	void reset_thread_list ();
 	void drop_threads ();
-	void run_one ();
+	void run_one (uint32_t& spin_budget);
+	void wait_for_work (uint32_t& spin_budget);
 	void main_thread ();
 	void prep ();
 
 	void helper_thread ();
+	void help_nested ();
+
+	void setup_affinity (uint32_t n_threads);
+	void update_affinity ();
+	void register_affinity_thread ();
+	void repin_threads ();
 
 	PBD::MPMCQueue<ProcessNode*> _trigger_queue;      ///< nodes that can be processed
 	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue
@@ -115,6 +134,13 @@ private:
 	/** The number of processing threads that are asleep */
 	std::atomic<uint32_t> _idle_thread_cnt;
 
+	/** Max time [usec] idle threads spin before waiting on _execution_sem */
+	std::atomic<uint32_t> _spin_usecs;
+
+	std::atomic<uint64_t> _n_cycles;
+	std::atomic<uint64_t> _n_spin_wakeups;
+	std::atomic<uint64_t> _n_sleep_wakeups;
+
 	/** Signalled to start a run of the graph for a process callback */
 	PBD::Semaphore _callback_start_sem;
 	PBD::Semaphore _callback_done_sem;
@@ -124,9 +150,23 @@ private:
 
 	bool _graph_empty;
 
+	/* tasks of a graph node that idle threads can help with */
+	std::atomic<RTTaskList*> _nested_tasklist;
+	std::atomic<uint32_t>    _nested_users;
+
 	/* number of background worker threads >= 0 */
 	std::atomic<uint32_t> _n_workers;
 
+	/* CPU affinity of process threads, see setup_affinity () */
+	std::vector<std::vector<int> > _cpu_domains;           ///< CPUs that process threads can be pinned to
+	std::vector<int>               _cpu_domain_of;         ///< logical CPU -> index of _cpu_domains
+	std::atomic<int>               _affinity_domain;       ///< domain that threads should use, or -1
+	std::atomic<uint32_t>          _affinity_generation;   ///< incremented when the domain changes
+	uint32_t                       _affinity_change_count; ///< backend thread only
+	Glib::Threads::Mutex           _affinity_lock;         ///< protects _affinity_threads, _affinity_applied
+	std::vector<pthread_t>         _affinity_threads;      ///< process threads to pin
+	uint32_t                       _affinity_applied;      ///< generation that _affinity_threads are pinned to
+
 	/* flag to terminate background threads */
 	std::atomic<int> _terminate;
 
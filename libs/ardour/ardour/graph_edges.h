@@ -46,8 +46,10 @@ class LIBARDOUR_API GraphEdges
 public:
 	void add (GraphVertex from, GraphVertex to, bool via_sends_only);
 	void remove (GraphVertex from, GraphVertex to);
+	/** add all edges of `other' that neither start nor end at a vertex in `skip' */
+	void add_all_except (GraphEdges const& other, std::set<GraphVertex> const& skip);
 
-	bool has (GraphVertex from, GraphVertex to, bool* via_sends_only);
+	bool has (GraphVertex from, GraphVertex to, bool* via_sends_only) const;
 	bool feeds (GraphVertex from, GraphVertex to) const;
 	/** @return the vertices that are directly fed from `r' */
 	std::set<GraphVertex> from (GraphVertex r) const;
@@ -64,6 +66,7 @@ private:
 	void insert (EdgeMap& e, GraphVertex a, GraphVertex b);
 
 	EdgeMapWithSends::iterator find_in_from_to_with_sends (GraphVertex, GraphVertex);
+	EdgeMapWithSends::const_iterator find_in_from_to_with_sends (GraphVertex, GraphVertex) const;
 	EdgeMapWithSends::iterator find_in_to_from_with_sends (GraphVertex, GraphVertex);
 
 	EdgeMapWithSends::const_iterator find_recursively_in_from_to_with_sends (GraphVertex, GraphVertex) const;
@@ -81,6 +84,7 @@ private:
 };
 
 bool topological_sort (GraphNodeList&, GraphEdges&);
+bool topological_sort (GraphNodeList&, GraphEdges&, GraphEdges const& known, std::set<GraphVertex> const& changed);
 
 }
 
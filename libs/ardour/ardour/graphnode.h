@@ -85,6 +85,10 @@ public:
 
 	virtual bool direct_feeds_according_to_reality (std::shared_ptr<GraphNode>, bool* via_send_only = 0) = 0;
 
+	/** pipelined nodes process data that was captured in the previous cycle,
+	 * they do not need to wait for nodes that feed them. */
+	virtual bool pipelined () const { return false; }
+
 protected:
 	void trigger ();
 	virtual void process () = 0;
@@ -26,6 +26,7 @@
 #ifndef __ardour_luaproc_h__
 #define __ardour_luaproc_h__
 
+#include <atomic>
 #include <set>
 #include <vector>
 #include <string>
@@ -37,6 +38,7 @@
 #  include "pbd/reallocpool.h"
 #endif
 
+#include "pbd/spinlock.h"
 #include "pbd/stateful.h"
 
 #include "ardour/types.h"
@@ -53,6 +55,8 @@ namespace luabridge {
 
 namespace ARDOUR {
 
+class LuaProcGC;
+
 class LIBARDOUR_API LuaProc : public ARDOUR::Plugin {
 public:
 	LuaProc (AudioEngine&, Session&, const std::string&);
@@ -127,6 +131,17 @@ public:
 	bool has_inline_display () { return _lua_has_inline_display; }
 	void setup_lua_inline_gui (LuaState *lua_gui);
 
+	/* garbage collection statistics */
+	struct GCStats {
+		int64_t kbytes;      ///< memory used by the interpreter [KiB]
+		int64_t time_avg;    ///< average time spent in process context per cycle [usec]
+		int64_t time_max;    ///< maximum time spent in process context [usec]
+		int64_t deferred;    ///< number of cycles that exceeded the budget
+		int64_t helper_time; ///< total time spent in the background helper [usec]
+	};
+
+	GCStats gc_stats () const;
+
 	DSP::DspShm* instance_shm () { return &lshm; }
 	LuaTableRef* instance_ref () { return &lref; }
 
@@ -211,6 +226,26 @@ private:
 	bool _has_midi_input;
 	bool _has_midi_output;
 
+	/* Garbage collection. With a budget (lua-dsp-gc-budget) the collector
+	 * only runs in gc_step (process thread) for at most the given time,
+	 * remaining work is done by the LuaProcGC thread while the script is idle.
+	 */
+	friend class LuaProcGC;
+	void gc_step ();
+	void gc_idle_work ();
+
+	PBD::spinlock_t      _gc_lock; /* interpreter access: process thread vs. LuaProcGC */
+	std::atomic<bool>    _gc_rt_waiting;
+	std::atomic<bool>    _gc_pending;
+	bool                 _gc_budgeted;
+	bool                 _gc_emergency; /* collector restarted, memory pool runs low */
+	int                  _gc_baseline;
+	std::atomic<int64_t> _gc_kbytes;
+	std::atomic<int64_t> _gc_time_sum;
+	std::atomic<int64_t> _gc_time_max;
+	std::atomic<int64_t> _gc_cycles;
+	std::atomic<int64_t> _gc_deferred;
+	std::atomic<int64_t> _gc_helper_time;
 
 #ifdef WITH_LUAPROC_STATS
 	int64_t _stats_avg[2];
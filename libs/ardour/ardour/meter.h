@@ -94,6 +94,8 @@ protected:
 private:
 	friend class IO;
 
+	void reset_dsp_meters (int types);
+
 	/** The number of meters that we are currently handling;
 	 *  may be different to _configured_input and _configured_output
 	 *  as it can be altered outside a \ref configure_io by \ref reflect_inputs .
@@ -114,6 +116,11 @@ private:
 	std::vector<Iec2ppmdsp*> _iec2meter;
 	std::vector<Vumeterdsp*> _vumeter;
 
+	/* K, IEC and VU meters are only computed while they are being read */
+	std::atomic<int> _observed_types; ///< DSP meter-types read since the last check
+	int              _process_types;  ///< DSP meter-types computed in ::run
+	samplecnt_t      _observe_cnt;
+
 	MeterType _meter_type;
 };
 
@@ -21,6 +21,7 @@
 #define _ardour_mp3file_importable_source_h_
 
 #include <stdint.h>
+#include <vector>
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -63,6 +64,20 @@ public:
 private:
 	void unmap_mem ();
 	int  decode_mp3 (bool parse_only = false);
+	void seek_to_frame (size_t);
+
+	/* byte offset of each MPEG frame, indexed by its first sample.
+	 * This is collected while scanning the file-length, and allows
+	 * to directly jump to the frame in question when seeking,
+	 * instead of re-parsing the file from the start.
+	 */
+	struct SeekPoint {
+		SeekPoint (samplepos_t s, size_t o) : sample (s), offset (o) {}
+		samplepos_t sample;
+		size_t      offset;
+	};
+
+	std::vector<SeekPoint> _seek_index;
 
 	mp3dec_t            _mp3d;
 	mp3dec_frame_info_t _info;
@@ -73,6 +88,7 @@ private:
 	size_t         _map_length;
 
 	const uint8_t* _buffer;
+	const uint8_t* _frame_start;
 	size_t         _remain;
 
 	samplepos_t   _read_position;
@@ -0,0 +1,85 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_pipeline_delay_h__
+#define __ardour_pipeline_delay_h__
+
+#include <vector>
+
+#include "ardour/chan_count.h"
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioBuffer;
+class BufferSet;
+class MidiBuffer;
+
+/** Multichannel Audio/Midi FIFO with a constant delay
+ *
+ * Unlike FixedDelay, writing and reading are separate operations:
+ * data is written after the process-graph completed a cycle, and read
+ * when the route is processed in the following cycle. Both may happen
+ * in sub-cycles of different size, the delay between the written and
+ * read data remains constant.
+ *
+ * There is no thread safety: write() and read() must not be called
+ * concurrently (which is guaranteed by the process-graph).
+ */
+class LIBARDOUR_API PipelineDelay
+{
+public:
+	PipelineDelay ();
+	~PipelineDelay ();
+
+	/** allocate buffers (not realtime safe), the FIFO is flushed if the configuration changes
+	 *
+	 * @param count Channel Count (audio+midi)
+	 * @param delay number of samples to delay, also the max. number of samples per read
+	 */
+	void configure (ChanCount const& count, samplecnt_t delay);
+
+	/** drop all data, and prime the FIFO with silence */
+	void flush ();
+
+	/** append @a n_samples from the given buffers */
+	void write (BufferSet const&, pframes_t n_samples);
+
+	/** consume @a n_samples that were written @a delay samples earlier */
+	void read (BufferSet&, pframes_t n_samples);
+
+	/** @return configured delay time in samples */
+	samplecnt_t delay () const { return _delay; }
+
+private:
+	void clear ();
+	void skip (samplecnt_t);
+	void pad (samplecnt_t);
+
+	ChanCount   _count;
+	samplecnt_t _delay;
+	samplecnt_t _size; ///< ring-buffer size per audio channel
+	samplecnt_t _rpos; ///< audio read position
+	samplecnt_t _fill; ///< samples that can be read
+
+	std::vector<AudioBuffer*> _audio;
+	std::vector<MidiBuffer*>  _midi; ///< event times are relative to the read position
+};
+
+} // namespace ARDOUR
+
+#endif // __ardour_pipeline_delay_h__
@@ -53,6 +53,7 @@ namespace ARDOUR {
 class Session;
 class Route;
 class Plugin;
+class RTTaskList;
 
 /** Plugin inserts: send data through a plugin
  */
@@ -427,6 +428,7 @@ private:
 
 	bool sanitize_maps ();
 	bool check_inplace ();
+	bool check_parallel_instances () const;
 	void mapping_changed ();
 
 	std::shared_ptr<Plugin> plugin_factory (std::shared_ptr<Plugin>);
@@ -449,6 +451,24 @@ private:
 	PBD::TimingStats  _timing_stats;
 	std::atomic<int> _stat_reset;
 	std::atomic<int> _flush;
+
+	/* replicated plugin instances that use disjoint buffers
+	 * can be processed concurrently by graph worker threads */
+	struct InstanceCycle {
+		BufferSet*  bufs;
+		samplepos_t start;
+		samplepos_t end;
+		double      speed;
+		pframes_t   nframes;
+		samplecnt_t offset;
+	};
+
+	void run_instance (uint32_t);
+
+	bool                        _parallel_instances;
+	std::shared_ptr<RTTaskList> _instance_tasks;
+	InstanceCycle               _instance_cycle;
+	std::atomic<bool>           _instance_failed;
 };
 
 } // namespace ARDOUR
@@ -32,12 +32,15 @@
 #include <map>
 #include <string>
 #include <set>
+#include <vector>
+#include <boost/function.hpp>
 #include <boost/utility.hpp>
 #include <boost/container/set.hpp>
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/plugin.h"
+#include "ardour/plugin_scan_index.h"
 #include "ardour/plugin_scan_result.h"
 
 #ifdef AUDIOUNIT_SUPPORT
@@ -196,6 +199,8 @@ private:
 	typedef boost::container::set<PSLEPtr, PSLEPtrSort> PluginScanLog;
 	PluginScanLog _plugin_scan_log;
 
+	PluginScanIndex _scan_index;
+
 	PSLEPtr scan_log_entry (PluginType const type, std::string const& path) {
 		PSLEPtr psl = PSLEPtr (new PluginScanLogEntry (type, path));
 		PluginScanLog::iterator i = _plugin_scan_log.find (psl);
@@ -304,6 +309,18 @@ private:
 
 	bool no_timeout () const { return _cancel_scan_timeout_one || _cancel_scan_timeout_all; }
 
+	struct ScannerJob {
+		ScannerJob (std::string const& p, PSLEPtr l) : path (p), psle (l), completed (false) {}
+
+		std::string              path;      ///< passed to the scanner app
+		PSLEPtr                  psle;
+		boost::function<void ()> start;     ///< called before the scanner is launched
+		boost::function<void ()> abort;     ///< called when the scan is cancelled or timed out
+		bool                     completed; ///< the scanner app ran until it exited
+	};
+
+	void run_scanner_apps (std::string const& scanner_bin, std::string const& title, std::vector<ScannerJob>&);
+
 	void detect_name_ambiguities (ARDOUR::PluginInfoList*);
 	void detect_type_ambiguities (ARDOUR::PluginInfoList&);
 
@@ -346,15 +363,19 @@ private:
 	int lxvst_discover_from_path (std::string path, bool cache_only = false);
 #if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
 	bool vst2_plugin (std::string const& module_path, ARDOUR::PluginType, VST2Info const&);
-	bool run_vst2_scanner_app (std::string bundle_path, PSLEPtr) const;
+	bool run_vst2_scanner_app (std::string bundle_path, PSLEPtr);
 	int vst2_discover (std::string path, ARDOUR::PluginType, bool cache_only = false);
+	std::string vst2_indexed_cache_file (std::string const& path, ARDOUR::PluginType, bool* is_new);
+	void vst2_prescan (std::vector<std::string> const&, ARDOUR::PluginType, std::set<std::string>& skip);
 #endif
 
 	int vst3_discover_from_path (std::string const& path, bool cache_only = false);
 	int vst3_discover (std::string const& path, bool cache_only = false);
 #ifdef VST3_SUPPORT
 	void vst3_plugin (std::string const&, std::string const&, VST3Info const&);
-	bool run_vst3_scanner_app (std::string bundle_path, PSLEPtr) const;
+	bool run_vst3_scanner_app (std::string bundle_path, PSLEPtr);
+	std::string vst3_indexed_cache_file (std::string const& module_path, bool* is_new);
+	void vst3_prescan (std::vector<std::string> const&, std::set<std::string>& skip);
 #endif
 
 	int ladspa_discover (std::string path);
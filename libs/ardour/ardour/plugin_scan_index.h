@@ -0,0 +1,73 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_plugin_scan_index_h_
+#define _ardour_plugin_scan_index_h_
+
+#include <map>
+#include <string>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Persistent index of scanned plugin modules.
+ *
+ * For each module the index records its modification time and size, as
+ * well as the modification time and format version of the cache-file
+ * (.v3i, .vst2) that was written by the scanner. The cache-files remain
+ * the authoritative scan result, the index allows to skip validating
+ * unchanged cache-files, and to detect modules that changed in place.
+ */
+class LIBARDOUR_API PluginScanIndex
+{
+public:
+	PluginScanIndex (std::string const& path);
+
+	enum Status {
+		Unknown,   ///< not indexed, the cache-file changed, or uses a different format version
+		Unchanged, ///< module and cache-file are unchanged
+		Modified,  ///< module was modified since it was scanned
+	};
+
+	Status status (PluginType, std::string const& module_path, std::string const& cache_file, int cache_version) const;
+
+	void update (PluginType, std::string const& module_path, std::string const& cache_file, int cache_version);
+	void remove (PluginType, std::string const& module_path);
+
+	bool load ();
+	bool save ();
+
+private:
+	struct Entry {
+		int64_t module_mtime;
+		int64_t module_size;
+		int64_t cache_mtime;
+		int64_t cache_version;
+	};
+
+	typedef std::pair<PluginType, std::string> Key;
+	typedef std::map<Key, Entry> Index;
+
+	std::string _path;
+	Index       _index;
+	bool        _dirty;
+};
+
+} // namespace ARDOUR
+
+#endif /* _ardour_plugin_scan_index_h_ */
@@ -19,6 +19,7 @@
 #ifndef _ardour_polarity_processor_h__
 #define _ardour_polarity_processor_h__
 
+#include "ardour/gain_stage.h"
 #include "ardour/processor.h"
 #include "ardour/types.h"
 
@@ -26,7 +27,7 @@ namespace ARDOUR {
 
 class PhaseControl;
 
-class LIBARDOUR_API PolarityProcessor : public Processor
+class LIBARDOUR_API PolarityProcessor : public Processor, public GainStage
 {
 public:
 	PolarityProcessor (Session&, std::shared_ptr<PhaseControl>);
@@ -36,6 +37,10 @@ public:
 	bool configure_io (ChanCount in, ChanCount out);
 	bool can_support_io_configuration (const ChanCount& in, ChanCount& out);
 
+	bool setup_gain_stage (BufferSet const&);
+	void gain_stage (uint32_t chn, gain_t& current, gain_t& target) const;
+	void set_gain_stage (uint32_t chn, gain_t current);
+
 	std::shared_ptr<PhaseControl> phase_control() {
 		return _control;
 	}
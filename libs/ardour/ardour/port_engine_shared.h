@@ -43,6 +43,7 @@ class BackendPort;
 
 typedef std::shared_ptr<BackendPort> BackendPortPtr;
 typedef std::shared_ptr<BackendPort> const & BackendPortHandle;
+typedef std::vector<BackendPortPtr>  BackendPortList;
 
 class LIBARDOUR_API BackendPort : public ProtoPort
 {
@@ -89,6 +90,14 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 		return _connections;
 	}
 
+	/** Connections for use in the process thread.
+	 * Unlike get_connections () this is safe to use while
+	 * ports are connected or disconnected concurrently.
+	 */
+	std::shared_ptr<BackendPortList const> rt_connections () const {
+		return _rt_connections.reader ();
+	}
+
 	int  connect (BackendPortHandle port, BackendPortHandle self);
 	int  disconnect (BackendPortHandle port, BackendPortHandle self);
 	void disconnect_all (BackendPortHandle self);
@@ -116,8 +125,11 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
+	SerializedRCUManager<BackendPortList> _rt_connections;
+
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
+	void update_rt_connections ();
 
 }; // class BackendPort
 
@@ -32,6 +32,8 @@
 #include "pbd/rcu.h"
 #include "pbd/ringbuffer.h"
 
+#include "zita-resampler/vmcresampler.h"
+
 #include "ardour/chan_count.h"
 #include "ardour/midiport_manager.h"
 #include "ardour/monitor_port.h"
@@ -96,10 +98,13 @@ public:
 	typedef std::shared_ptr<DPM>                  AudioPortMeter;
 	typedef std::shared_ptr<MPM>                  MIDIPortMeter;
 
+	typedef std::shared_ptr<std::atomic<bool> > InputPortActive;
+
 	struct AudioInputPort {
 		AudioInputPort (samplecnt_t);
-		AudioPortScope scope;
-		AudioPortMeter meter;
+		AudioPortScope  scope;
+		AudioPortMeter  meter;
+		InputPortActive active;
 		void apply_falloff (pframes_t, samplecnt_t sr, bool reset = false);
 		void silence (pframes_t);
 		void process (Sample const*, pframes_t, bool reset = false);
@@ -109,6 +114,7 @@ public:
 		MIDIInputPort (samplecnt_t);
 		MIDIPortMonitor monitor;
 		MIDIPortMeter   meter;
+		InputPortActive active;
 		void apply_falloff (pframes_t, samplecnt_t sr, bool reset = false);
 		void process_event (uint8_t const*, size_t);
 	};
@@ -149,6 +155,28 @@ public:
 	int reestablish_ports ();
 	int reconnect_ports ();
 
+	/* Batched connection changes
+	 *
+	 * Ports are (dis)connected immediately, but notifications are deferred
+	 * until the outermost batch is committed. PortConnectedOrDisconnected
+	 * is then emitted once for every net change, and GraphReordered
+	 * at most once. Batches may be nested.
+	 *
+	 * Batches are only used by non-realtime threads, they are ignored
+	 * in the backend's process thread, and notifications from the
+	 * process thread are not deferred.
+	 */
+	void begin_connection_batch ();
+	void commit_connection_batch ();
+
+	class LIBARDOUR_API ConnectionBatch {
+	public:
+		ConnectionBatch (PortManager& pm) : _pm (pm) { _pm.begin_connection_batch (); }
+		~ConnectionBatch () { _pm.commit_connection_batch (); }
+	private:
+		PortManager& _pm;
+	};
+
 	bool connected (const std::string&);
 	bool physically_connected (const std::string&);
 	int  get_connections (const std::string&, std::vector<std::string>&);
@@ -268,6 +296,13 @@ public:
 	/* Input port meters and monitors */
 	void reset_input_meters ();
 
+	/** Meters and scopes of physical input ports are only processed
+	 * while at least one client (GUI, control surface, Lua) subscribed.
+	 * Every subscription must be matched by an unsubscribe call.
+	 */
+	void subscribe_input_meter (std::string const& port_name);
+	void unsubscribe_input_meter (std::string const& port_name);
+
 	AudioInputPorts audio_input_ports () const;
 	MIDIInputPorts  midi_input_ports () const;
 
@@ -275,6 +310,14 @@ public:
 		return _monitor_port;
 	}
 
+	/** Varispeed resampler state shared by all audio ports of the given
+	 * direction. It is prepared once per cycle by cycle_start() (input)
+	 * and cycle_end() (output), ports only apply it to their own data.
+	 */
+	ArdourZita::VMCResampler const& port_resampler (bool input) const {
+		return input ? _input_src : _output_src;
+	}
+
 protected:
 	std::shared_ptr<AudioBackend> _backend;
 
@@ -321,9 +364,15 @@ private:
 	void load_port_info ();
 	void save_port_info ();
 	void update_input_ports (bool);
+	void activate_input_meter (std::string const&, bool);
+	void setup_resamplers ();
 
 	MonitorPort _monitor_port;
 
+	pframes_t                _port_buffer_size;
+	ArdourZita::VMCResampler _input_src;
+	ArdourZita::VMCResampler _output_src;
+
 	struct PortID {
 		PortID (std::shared_ptr<AudioBackend>, DataType, bool, std::string const&);
 		PortID (XMLNode const&, bool old_midi_format = false);
@@ -389,6 +438,25 @@ private:
 	SerializedRCUManager<AudioInputPorts> _audio_input_ports;
 	SerializedRCUManager<MIDIInputPorts>  _midi_input_ports;
 	std::atomic<int>                     _reset_meters;
+
+	Glib::Threads::Mutex       _input_meter_lock; // protects _input_meter_subscriptions
+	std::map<std::string, int> _input_meter_subscriptions;
+
+	struct ConnectionChange {
+		ConnectionChange (std::string const& a, std::string const& b, bool c)
+			: a (a), b (b), connected (c) {}
+		std::string a;
+		std::string b;
+		bool        connected;
+	};
+
+	void emit_connection_change (std::string const&, std::string const&, bool);
+	bool in_backend_process_thread () const;
+
+	Glib::Threads::Mutex          _connection_batch_lock; // protects all below
+	int                           _connection_batch_depth;
+	bool                          _connection_batch_reorder;
+	std::vector<ConnectionChange> _connection_batch;
 };
 
 } // namespace ARDOUR
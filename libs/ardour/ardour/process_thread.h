@@ -39,7 +39,7 @@ public:
 
 	void init();
 
-	void get_buffers ();
+	void get_buffers (bool local = false);
 	void drop_buffers ();
 
 	/* these MUST be called by a process thread's thread, nothing else */
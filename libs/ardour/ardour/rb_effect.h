@@ -35,6 +35,8 @@ class LIBARDOUR_API RBEffect : public Filter {
 	int run (std::shared_ptr<ARDOUR::Region>, PBD::Progress* progress = 0);
 
   private:
+	int run_segmented (std::shared_ptr<AudioRegion>, SourceList&, samplepos_t read_start, samplecnt_t read_duration, double stretch, double shift, PBD::Progress*);
+
 	TimeFXRequest& tsr;
 };
 
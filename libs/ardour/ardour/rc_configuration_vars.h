@@ -76,6 +76,7 @@ CONFIG_VARIABLE (bool, first_midi_bank_is_zero, "display-first-midi-bank-as-zero
 CONFIG_VARIABLE (int32_t, inter_scene_gap_samples, "inter-scene-gap-samples", 1)
 CONFIG_VARIABLE (bool, midi_input_follows_selection, "midi-input-follows-selection", 1)
 CONFIG_VARIABLE (std::string, default_trigger_input_port, "default-trigger-input-port", "")
+CONFIG_VARIABLE (uint32_t, clip_cache_size_mb, "clip-cache-size-mb", 256)
 
 /* Timecode and related */
 
@@ -220,6 +221,8 @@ CONFIG_VARIABLE (std::string, clip_library_dir, "clip-library-dir", "@default@")
 CONFIG_VARIABLE (std::string, sample_lib_path, "sample-lib-path", "") /* custom paths */
 CONFIG_VARIABLE (bool, allow_special_bus_removal, "allow-special-bus-removal", false)
 CONFIG_VARIABLE (int32_t, processor_usage, "processor-usage", -1)
+CONFIG_VARIABLE (bool, pin_process_threads, "pin-process-threads", false) /* keep process threads on CPUs that share a cache with the backend's thread */
+CONFIG_VARIABLE (bool, process_threads_avoid_smt, "process-threads-avoid-smt", false) /* only with pin-process-threads */
 CONFIG_VARIABLE (int32_t, cpu_dma_latency, "cpu-dma-latency", -1) /* >=0 to enable */
 CONFIG_VARIABLE (gain_t, max_gain, "max-gain", 2.0) /* +6.0dB */
 CONFIG_VARIABLE (uint32_t, max_recent_sessions, "max-recent-sessions", 10)
@@ -248,7 +251,11 @@ CONFIG_VARIABLE (bool, ask_replace_instrument, "ask-replace-instrument", true)
 CONFIG_VARIABLE (bool, ask_setup_instrument, "ask-setup-instrument", true)
 CONFIG_VARIABLE (bool, setup_sidechain, "setup-sidechain", false)
 CONFIG_VARIABLE (uint32_t, plugin_scan_timeout, "plugin-scan-timeout", 150) /* deci-seconds */
+CONFIG_VARIABLE (uint32_t, plugin_scan_jobs, "plugin-scan-jobs", 0) /* concurrent scanner processes, 0: number of CPUs */
 CONFIG_VARIABLE (uint32_t, limit_n_automatables, "limit-n-automatables", 512)
+CONFIG_VARIABLE (uint32_t, lua_dsp_gc_budget, "lua-dsp-gc-budget", 0) /* microseconds per cycle, 0: no budget */
+CONFIG_VARIABLE (bool, parallel_plugin_instances, "parallel-plugin-instances", false)
+CONFIG_VARIABLE (bool, convolver_thread_pool, "convolver-thread-pool", true)
 CONFIG_VARIABLE (uint32_t, plugin_cache_version, "plugin-cache-version", 0)
 
 /* custom user plugin paths */
@@ -55,6 +55,7 @@
 #include "ardour/muteable.h"
 #include "ardour/mute_master.h"
 #include "ardour/mute_control.h"
+#include "ardour/pipeline_delay.h"
 #include "ardour/route_group_member.h"
 #include "ardour/stripable.h"
 #include "ardour/graphnode.h"
@@ -201,6 +202,14 @@ public:
 	void set_denormal_protection (bool yn);
 	bool denormal_protection() const;
 
+	/** Process this route one cycle late, using input data captured at the
+	 * end of the previous cycle. This adds one period of latency, but the
+	 * route no longer waits for the routes that feed it.
+	 * Only busses can be pipelined.
+	 */
+	bool set_pipelined (bool yn);
+	bool pipelined () const { return _pipelined; }
+
 	void         set_meter_point (MeterPoint);
 	bool         apply_processor_changes_rt ();
 	void         emit_pending_signals ();
@@ -380,6 +389,7 @@ public:
 
 	PBD::Signal0<void> active_changed;
 	PBD::Signal0<void> denormal_protection_changed;
+	PBD::Signal0<void> pipelined_changed;
 	PBD::Signal0<void> comment_changed;
 
 	bool is_track();
@@ -587,6 +597,9 @@ protected:
 
 	virtual void set_block_size (pframes_t nframes);
 
+	void pipeline_capture (pframes_t nframes);
+	void configure_pipeline ();
+
 	virtual int no_roll_unlocked (pframes_t nframes, samplepos_t start_sample, samplepos_t end_sample, bool session_state_changing);
 
 	virtual void snapshot_out_of_band_data (samplecnt_t /* nframes */) {}
@@ -599,6 +612,8 @@ protected:
 	                             bool gain_automation_ok,
 	                             bool run_disk_processors);
 
+	bool run_gain_stages (BufferSet&, pframes_t, ProcessorList::const_iterator&);
+
 	void flush_processor_buffers_locked (samplecnt_t nframes);
 
 	virtual void bounce_process (BufferSet& bufs,
@@ -655,6 +670,8 @@ protected:
 	MeterPoint     _pending_meter_point;
 
 	bool           _denormal_protection;
+	bool           _pipelined;
+	PipelineDelay  _pipeline;
 
 	bool _recordable : 1;
 
@@ -19,6 +19,7 @@
 #ifndef _ardour_rt_tasklist_h_
 #define _ardour_rt_tasklist_h_
 
+#include <atomic>
 #include <boost/function.hpp>
 #include <vector>
 
@@ -38,11 +39,24 @@ public:
 	void process ();
 	void push_back (boost::function<void ()> fn);
 
+	/** process tasks in list, from within a graph node while the
+	 * process graph is running. Idle graph threads help with the work.
+	 * Unlike process(), the list is retained, so that it can be
+	 * re-used in the next cycle without allocating memory.
+	 */
+	void process_nested ();
+
 	std::vector<RTTask> const& tasks () const { return _tasks; }
 
 private:
+	friend class Graph;
+
+	/** claim and run the next unclaimed task, return false if there is none */
+	bool run_next ();
+
 	std::vector<RTTask>      _tasks;
 	std::shared_ptr<Graph> _graph;
+	std::atomic<size_t>    _next;
 };
 
 } // namespace ARDOUR
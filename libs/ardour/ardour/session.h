@@ -332,6 +332,7 @@ public:
 	}
 
 	std::shared_ptr<RTTaskList> rt_tasklist () { return _rt_tasklist; }
+	std::shared_ptr<Graph> process_graph () const { return _process_graph; }
 
 	RouteList get_routelist (bool mixer_order = false, PresentationInfo::Flag fl = PresentationInfo::MixerRoutes) const;
 
@@ -752,7 +753,7 @@ public:
 	void remove_routes (std::shared_ptr<RouteList>);
 	void remove_route (std::shared_ptr<Route>);
 
-	void resort_routes ();
+	void resort_routes (std::weak_ptr<Route> changed = std::weak_ptr<Route> ());
 
 	AudioEngine & engine() { return _engine; }
 	AudioEngine const & engine () const { return _engine; }
@@ -1391,6 +1392,9 @@ public:
 
 	PBD::TimingStats dsp_stats[NTT];
 
+	GraphWakeupStats graph_wakeup_stats () const;
+	void             reset_graph_wakeup_stats ();
+
 	int32_t first_cue_within (samplepos_t s, samplepos_t e, bool& was_recorded);
 	void trigger_cue_row (int32_t);
 	CueEvents const & cue_events() const { return _cue_events; }
@@ -1411,7 +1415,11 @@ protected:
 	void set_sample_rate (samplecnt_t nframes);
 
 	friend class Route;
-	void update_latency_compensation (bool force, bool called_from_backend);
+	/* An incremental update only re-computes routes that changed and
+	 * routes downstream of them. If a route's own latency changed, the
+	 * engine's latency callback still updates all routes, O(graph).
+	 */
+	void update_latency_compensation (bool force, bool called_from_backend, bool incremental = false);
 
 	/* transport API */
 
@@ -1504,7 +1512,7 @@ private:
 
 	void update_latency (bool playback);
 	void set_owned_port_public_latency (bool playback);
-	bool update_route_latency (bool reverse, bool apply_to_delayline, bool* delayline_update_needed);
+	bool update_route_latency (bool reverse, bool apply_to_delayline, bool* delayline_update_needed, RouteList const* dirty = 0);
 	void initialize_latencies ();
 	void set_worst_output_latency ();
 	void set_worst_input_latency ();
@@ -1593,6 +1601,7 @@ private:
 
 	void get_track_statistics ();
 	int  process_routes (pframes_t, bool& need_butler);
+	void capture_pipelined_routes (pframes_t);
 	int  silent_process_routes (pframes_t, bool& need_butler);
 
 	/** @return 1 if there is a pending declick fade-in,
@@ -1796,12 +1805,24 @@ private:
 	AutoConnectQueue     _auto_connect_queue;
 	std::atomic<unsigned int>   _latency_recompute_pending;
 
+	/* routes whose processor latency changed since the last
+	 * incremental update_latency_compensation (). An empty list
+	 * means that nothing changed, a null pointer that all routes
+	 * need to be updated. */
+	typedef std::set<std::weak_ptr<Route>, std::owner_less<std::weak_ptr<Route> > > WeakRouteSet;
+	Glib::Threads::Mutex _latency_dirty_lock; // protects _latency_dirty_*
+	WeakRouteSet         _latency_dirty_routes;
+	bool                 _latency_dirty_all;
+
 	void get_physical_ports (std::vector<std::string>& inputs, std::vector<std::string>& outputs, DataType type,
 	                         MidiPortFlags include = MidiPortFlags (0),
 	                         MidiPortFlags exclude = MidiPortFlags (0));
 
 	void auto_connect (const AutoConnectRequest&);
 	void queue_latency_recompute ();
+	void queue_route_latency_recompute (std::weak_ptr<Route>);
+	void mark_route_latency_dirty (std::weak_ptr<Route>);
+	std::shared_ptr<RouteList> take_latency_dirty_routes ();
 
 	/* SessionEventManager interface */
 
@@ -1976,7 +1997,7 @@ private:
 	std::shared_ptr<Route> XMLRouteFactory_2X (const XMLNode&, int);
 	std::shared_ptr<Route> XMLRouteFactory_3X (const XMLNode&, int);
 
-	void route_processors_changed (RouteProcessorChange);
+	void route_processors_changed (RouteProcessorChange, std::weak_ptr<Route> wr = std::weak_ptr<Route> ());
 
 	bool find_route_name (std::string const &, uint32_t& id, std::string& name, bool);
 	void count_existing_track_channels (ChanCount& in, ChanCount& out);
@@ -2318,16 +2339,24 @@ private:
 	 * and solo/mute computations.
 	 */
 	GraphEdges _current_route_graph;
+	/** The nodes that _current_route_graph was collected for */
+	std::set<GraphVertex> _current_route_graph_nodes;
+	/** Copy of _current_route_graph for use outside of the GUI/engine thread
+	 * that re-sorts routes, e.g. incremental latency updates.
+	 */
+	SerializedRCUManager<GraphEdges> _route_graph_edges;
+
+	void set_current_route_graph (GraphEdges const&, std::set<GraphVertex> const&);
 
 	friend class IOPlug;
 	std::shared_ptr<Graph>      _process_graph;
 	std::shared_ptr<GraphChain> _graph_chain;
 	std::shared_ptr<GraphChain> _io_graph_chain[2];
 
-	void resort_routes_using (std::shared_ptr<RouteList>);
+	void resort_routes_using (std::shared_ptr<RouteList>, std::shared_ptr<Route> changed = std::shared_ptr<Route> ());
 	void resort_io_plugs ();
 
-	bool rechain_process_graph (GraphNodeList&);
+	bool rechain_process_graph (GraphNodeList&, std::shared_ptr<Route> changed);
 	bool rechain_ioplug_graph (bool);
 
 	void ensure_route_presentation_info_gap (PresentationInfo::order_t, uint32_t gap_size);
@@ -66,6 +66,7 @@ CONFIG_VARIABLE (bool, midi_copy_is_fork, "midi-copy-is-fork", true)
 CONFIG_VARIABLE (bool, tracks_follow_session_time, "tracks-follow-session-time", false)
 CONFIG_VARIABLE (bool, realtime_export, "realtime-export", false)
 CONFIG_VARIABLE (bool, use_surround_master, "use-surround-master", false)
+CONFIG_VARIABLE (uint32_t, graph_worker_spin_usecs, "graph-worker-spin-usecs", 0) /* 0: idle process threads always sleep */
 
 /* Video-settings are saved with the session and belong to the session.
  * headless ardour could remote control xjadeo for example.
@@ -148,15 +148,14 @@ public:
 	static bool has_per_thread_pool ();
 	static void create_per_thread_pool (const std::string& n, uint32_t nitems);
 	static void init_event_pool ();
+	static void refill_pool ();
 	static guint pool_available ();
 
-	PBD::CrossThreadPool* event_pool() const { return own_pool; }
+	static PBD::MagazinePool::Stats pool_stats ();
+	static void reset_pool_stats ();
 
 private:
-	static PBD::PerThreadPool* pool;
-	PBD::CrossThreadPool*      own_pool;
-
-	friend class Butler;
+	static PBD::MagazinePool* pool;
 };
 
 class SessionEventManager {
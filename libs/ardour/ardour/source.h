@@ -108,6 +108,7 @@ public:
 
 	AnalysisFeatureList transients;
 	std::string get_transients_path() const;
+	std::string get_analysis_path (std::string const& key) const;
 	int load_transients (const std::string&);
 
 	size_t n_captured_xruns () const { return _xruns.size (); }
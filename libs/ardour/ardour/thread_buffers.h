@@ -37,6 +37,7 @@ public:
 	~ThreadBuffers ();
 
 	void ensure_buffers (ChanCount howmany = ChanCount::ZERO, size_t custom = 0);
+	void reallocate ();
 
 	BufferSet* silent_buffers;
 	BufferSet* scratch_buffers;
@@ -50,8 +51,12 @@ public:
 	pan_t**    pan_automation_buffer;
 	uint32_t   npan_buffers;
 
+	int        numa_node; ///< memory node of the thread that allocated the buffers, -1 if unknown
+
 private:
 	void allocate_pan_automation_buffers (samplecnt_t nframes, uint32_t howmany, bool force);
+
+	size_t _custom;
 };
 
 } // namespace
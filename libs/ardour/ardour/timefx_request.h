@@ -21,6 +21,7 @@
 
 #include "temporal/types.h"
 #include "ardour/interthread_info.h"
+#include "ardour/types.h"
 
 namespace ARDOUR {
 
@@ -31,7 +32,8 @@ namespace ARDOUR {
 			, use_soundtouch(false)
 			, quick_seek(false)
 			, antialias(false)
-			, opts(0) {}
+			, opts(0)
+			, segment_length(0) {}
 
 		Temporal::ratio_t time_fraction;
 		float pitch_fraction;
@@ -41,6 +43,11 @@ namespace ARDOUR {
 		bool  antialias;
 		/* RubberBand */
 		int   opts; // really RubberBandStretcher::Options
+		/* Split regions longer than twice this duration (in samples) into
+		 * overlapping segments, which are stretched concurrently and
+		 * cross-faded at the seams. 0: stretch the region in one pass.
+		 */
+		samplecnt_t segment_length;
 	};
 }
 
@@ -22,6 +22,7 @@
 #include <pthread.h>
 
 #include <atomic>
+#include <cmath>
 #include <map>
 #include <vector>
 #include <string>
@@ -30,6 +31,7 @@
 #include <glibmm/threads.h>
 
 #include "pbd/crossthread.h"
+#include "pbd/id.h"
 #include "pbd/pcg_rand.h"
 #include "pbd/pool.h"
 #include "pbd/properties.h"
@@ -482,6 +484,56 @@ class LIBARDOUR_API Trigger : public PBD::Stateful {
 	void send_property_change (PBD::PropertyChange pc);
 };
 
+/** Process-wide cache of audio clip data.
+ *
+ * Triggers using the same range of the same sources share a single,
+ * immutable copy of the audio data. Data that is no longer used by any
+ * trigger is retained up to the clip-cache-size-mb limit, least recently
+ * used data is evicted first.
+ */
+class LIBARDOUR_API AudioClipCache {
+  public:
+	struct Data : public std::vector<Sample*> {
+		Data () : length (0) {}
+		~Data ();
+
+		samplecnt_t length;
+
+		size_t bytes () const { return size () * length * sizeof (Sample); }
+	};
+
+	typedef std::shared_ptr<Data const> DataPtr;
+
+	/* reads the data if it is not cached. Not realtime safe */
+	static DataPtr get (std::shared_ptr<AudioRegion>);
+
+	/* evict unused data exceeding the configured limit */
+	static void trim ();
+	static void clear ();
+
+  private:
+	struct Key {
+		std::vector<PBD::ID> sources;
+		samplepos_t          start;
+		samplecnt_t          length;
+
+		bool operator< (Key const &) const;
+	};
+
+	struct Entry {
+		DataPtr  data;
+		uint64_t last_use;
+	};
+
+	typedef std::map<Key, Entry> Cache;
+
+	static Glib::Threads::Mutex _lock;
+	static Cache                _cache;
+	static uint64_t             _use_counter;
+
+	static void trim_locked ();
+};
+
 class LIBARDOUR_API AudioTrigger : public Trigger {
   public:
 	AudioTrigger (uint32_t index, TriggerBox&);
@@ -530,10 +582,32 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 
 	bool stretching () const;
 
+	/* Offline stretched copy of the data, rendered at a given ratio by
+	 * the TriggerBoxThread. While the tempo matches, this is played
+	 * back instead of stretching in realtime.
+	 */
+	struct StretchCache {
+		StretchCache (double r, StretchMode m) : ratio (r), mode (m), length (0) {}
+		~StretchCache ();
+
+		bool matches (double r, StretchMode m) const {
+			return m == mode && fabs (r - ratio) < 1e-9;
+		}
+
+		double               ratio;
+		StretchMode          mode;
+		samplecnt_t          length;
+		std::vector<Sample*> data;
+	};
+
+	void queue_prestretch ();
+	void prestretch (); /* called from the TriggerBoxThread */
+
   protected:
 	void retrigger ();
 
   private:
+	/* points into _clip_data, which may be shared with other triggers */
 	struct Data : std::vector<Sample*> {
 		samplecnt_t length;
 
@@ -541,9 +615,32 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	};
 
 	Data        data;
+	AudioClipCache::DataPtr _clip_data;
 	RubberBand::RubberBandStretcher*  _stretcher;
 	samplepos_t _start_offset;
 
+	/* rendered by the TriggerBoxThread, waiting to be picked up by the process thread */
+	std::atomic<StretchCache*> _pending_stretch_cache;
+	/* owned by the process thread */
+	StretchCache* _stretch_cache;
+	/* parameters of the last rendered cache, only used by the TriggerBoxThread */
+	double        _prestretch_ratio;
+	StretchMode   _prestretch_mode;
+
+	enum StretchCacheUse {
+		CacheUndecided,
+		CacheUsed,
+		CacheUnused
+	};
+
+	StretchCacheUse _cache_use;
+	samplecnt_t     _cache_index;
+
+	/* shared with queued prestretch requests, cleared when the trigger
+	 * is destroyed, to cancel them.
+	 */
+	std::shared_ptr<std::atomic<bool> > _alive;
+
 
 	/* computed during run */
 
@@ -657,8 +754,20 @@ class LIBARDOUR_API TriggerBoxThread
 
 	static void init_request_pool() { Request::init_pool(); }
 
+	/* shared by a TriggerBox and its queued Retempo request */
+	struct RetempoToken {
+		RetempoToken () : alive (true), queued (false) {}
+
+		Glib::Threads::Mutex lock;   /* held while the box is re-tempo'ed */
+		bool                 alive;  /* protected by lock */
+		std::atomic<bool>    queued; /* at most one request per box */
+	};
+
 	void set_region (TriggerBox&, uint32_t slot, std::shared_ptr<Region>);
 	void request_delete_trigger (Trigger* t);
+	bool request_prestretch (AudioTrigger*, std::shared_ptr<std::atomic<bool> > alive);
+	bool request_retempo (TriggerBox&, std::shared_ptr<RetempoToken>);
+	void request_delete_stretch_cache (AudioTrigger::StretchCache*);
 
 	void summon();
 	void stop();
@@ -671,7 +780,10 @@ class LIBARDOUR_API TriggerBoxThread
 	enum RequestType {
 		Quit,
 		SetRegion,
-		DeleteTrigger
+		DeleteTrigger,
+		PreStretch,
+		DeleteStretchCache,
+		Retempo
 	};
 
 	struct Request {
@@ -685,6 +797,13 @@ class LIBARDOUR_API TriggerBoxThread
 		std::shared_ptr<Region> region;
 		/* for DeleteTrigger */
 		Trigger* trigger;
+		/* for PreStretch */
+		AudioTrigger* audio_trigger;
+		std::shared_ptr<std::atomic<bool> > audio_trigger_alive;
+		/* for DeleteStretchCache */
+		AudioTrigger::StretchCache* stretch_cache;
+		/* for Retempo (and box) */
+		std::shared_ptr<RetempoToken> retempo;
 
 		void* operator new (size_t);
 		void  operator delete (void* ptr, size_t);
@@ -697,7 +816,8 @@ class LIBARDOUR_API TriggerBoxThread
 	PBD::RingBuffer<Request*>  requests;
 
 	CrossThreadChannel _xthread;
-	void queue_request (Request*);
+	bool can_queue_request () const;
+	bool queue_request (Request*);
 	void delete_trigger (Trigger*);
 };
 
@@ -800,6 +920,7 @@ class LIBARDOUR_API TriggerBox : public Processor
 	void enqueue_trigger_state_for_region (std::shared_ptr<Region>, std::shared_ptr<Trigger::UIState>);
 
 	void tempo_map_changed ();
+	void retempo (); /* called from the TriggerBoxThread */
 
 	/* valid only within the ::run() call tree */
 	int32_t active_scene() const { return _active_scene; }
@@ -881,6 +1002,8 @@ class LIBARDOUR_API TriggerBox : public Processor
 
 	PBD::PCGRand _pcg;
 
+	std::shared_ptr<TriggerBoxThread::RetempoToken> _retempo;
+
 	/* These four are accessed (read/write) only from process() context */
 
 	void drop_triggers ();
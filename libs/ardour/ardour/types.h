@@ -968,6 +968,17 @@ struct ProcessedRanges {
 	ProcessedRanges() : start { 0, 0 }, end { 0, 0 }, cnt (0) {}
 };
 
+/** Process-graph worker wake-ups, accumulated since the last reset.
+ * See SessionConfiguration::graph_worker_spin_usecs
+ */
+struct GraphWakeupStats {
+	GraphWakeupStats () : cycles (0), spins (0), sleeps (0) {}
+
+	uint64_t cycles; ///< number of graph runs
+	uint64_t spins;  ///< workers that found work while spinning
+	uint64_t sleeps; ///< workers that were woken up from the semaphore
+};
+
 } // namespace ARDOUR
 
 /* for now, break the rules and use "using" to make this "global" */
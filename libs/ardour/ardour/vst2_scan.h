@@ -28,6 +28,8 @@
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 
+#define ARDOUR_VST2_CACHE_FILE_VERSION 1
+
 namespace ARDOUR {
 
 struct VST2Info {
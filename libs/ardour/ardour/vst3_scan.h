@@ -27,6 +27,8 @@
 
 #include "ardour/libardour_visibility.h"
 
+#define ARDOUR_VST3_CACHE_FILE_VERSION 2
+
 namespace ARDOUR {
 class VST3PluginModule;
 }
@@ -23,6 +23,8 @@
 
 #include <stdint.h>
 
+#include <atomic>
+
 #include "pbd/pthread_utils.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/semutils.h"
@@ -32,6 +34,7 @@
 namespace ARDOUR {
 
 class Worker;
+class WorkerPool;
 
 /**
    An object that needs to schedule non-RT work in the audio thread.
@@ -54,9 +57,10 @@ public:
 /**
    A worker for non-realtime tasks scheduled from another thread.
 
-   A worker may be a separate thread that runs to execute scheduled work
-   asynchronously, or unthreaded, in which case work is executed immediately
-   upon scheduling by the calling thread.
+   A threaded worker executes scheduled work asynchronously, using a small
+   pool of threads that is shared by all workers.  Work scheduled on one
+   worker is executed in order, by one thread at a time.  An unthreaded
+   worker executes work immediately upon scheduling by the calling thread.
 */
 class LIBARDOUR_API Worker
 {
@@ -92,7 +96,13 @@ public:
 	void set_synchronous(bool synchronous) { _synchronous = synchronous; }
 
 private:
-	void run();
+	friend class WorkerPool;
+
+	/**
+	   Execute all pending requests (pool thread).
+	*/
+	void process_requests();
+
 	/**
 	   Peek in RB, get size and check if a block of 'size' is available.
 
@@ -108,9 +118,11 @@ private:
 	PBD::RingBuffer<uint8_t>* _requests;
 	PBD::RingBuffer<uint8_t>* _responses;
 	uint8_t*                  _response;
-	PBD::Semaphore            _sem;
-	PBD::Thread*              _thread;
-	bool                      _exit;
+	void*                     _work_buf;
+	size_t                    _work_buf_size;
+	WorkerPool*               _pool;
+	std::atomic<int>          _pending;
+	std::atomic<bool>         _busy;
 	bool                      _synchronous;
 };
 
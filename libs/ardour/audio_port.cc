@@ -39,19 +39,55 @@ using namespace std;
 AudioPort::AudioPort (const std::string& name, PortFlags flags)
 	: Port (name, DataType::AUDIO, flags)
 	, _buffer (new AudioBuffer (0))
+	, _src_buf (0)
+	, _src_stale (true)
 	, _data (0)
 {
 	assert (name.find_first_of (':') == string::npos);
-	_src.setup (resampler_quality ());
-	_src.set_rrfilt (10);
+	alloc_src_buffer ();
 }
 
 AudioPort::~AudioPort ()
 {
 	if (_data) cache_aligned_free (_data);
+	delete [] _src_buf;
 	delete _buffer;
 }
 
+void
+AudioPort::alloc_src_buffer ()
+{
+	delete [] _src_buf;
+	_src_buf = 0;
+	_src_stale = true;
+
+	uint32_t n = ArdourZita::VMCResampler::bufsize (resampler_quality ());
+	if (n > 0) {
+		_src_buf = new Sample[n];
+	}
+}
+
+static void
+resample_port (ArdourZita::VMCResampler const& src, Sample* buf, bool& stale, Sample const* in, Sample* out, pframes_t n_out)
+{
+	if (stale) {
+		src.reset_channel (buf);
+		stale = false;
+	}
+
+	pframes_t n = src.process (buf, in, out);
+	assert (n <= n_out);
+
+	if (n == 0) {
+		memset (out, 0, n_out * sizeof (Sample));
+		return;
+	}
+	/* short read, repeat last sample */
+	for (; n < n_out; ++n) {
+		out[n] = out[n - 1];
+	}
+}
+
 void
 AudioPort::set_buffer_size (pframes_t nframes)
 {
@@ -69,20 +105,12 @@ AudioPort::cycle_start (pframes_t nframes)
 		_buffer->prepare ();
 	} else if (!externally_connected ()) {
 		/* ardour internal port, just silence input, don't resample */
-		_src.reset ();
+		_src_stale = true;
 		memset (_data, 0, _cycle_nframes * sizeof (float));
 	} else {
-		_src.inp_data  = (float*)port_engine.get_buffer (_port_handle, nframes);
-		_src.inp_count = nframes;
-		_src.out_count = _cycle_nframes;
-		_src.set_rratio (_cycle_nframes / (double)nframes);
-		_src.out_data  = _data;
-		_src.process ();
-		while (_src.out_count > 0) {
-			*_src.out_data =  _src.out_data[-1];
-			++_src.out_data;
-			--_src.out_count;
-		}
+		resample_port (ENGINE->port_resampler (true), _src_buf, _src_stale,
+		               (Sample const*)port_engine.get_buffer (_port_handle, nframes),
+		               _data, _cycle_nframes);
 	}
 }
 
@@ -103,22 +131,13 @@ AudioPort::cycle_end (pframes_t nframes)
 
 		if (!externally_connected ()) {
 			/* ardour internal port, data goes nowhere, skip resampling */
-			// TODO reset resampler only once
-			_src.reset ();
+			_src_stale = true;
 			return;
 		}
 
-		_src.inp_count = _cycle_nframes;
-		_src.out_count = nframes;
-		_src.set_rratio (nframes / (double)_cycle_nframes);
-		_src.inp_data  = _data;
-		_src.out_data  = (float*)port_engine.get_buffer (_port_handle, nframes);
-		_src.process ();
-		while (_src.out_count > 0) {
-			*_src.out_data =  _src.out_data[-1];
-			++_src.out_data;
-			--_src.out_count;
-		}
+		resample_port (ENGINE->port_resampler (false), _src_buf, _src_stale,
+		               _data, (Sample*)port_engine.get_buffer (_port_handle, nframes),
+		               nframes);
 	}
 }
 
@@ -150,10 +169,9 @@ AudioPort::reinit (bool with_ratio)
 	if (with_ratio) {
 		/* Note: latency changes with quality, caller
 		 * must take care of updating port latencies */
-		_src.setup (resampler_quality ());
-		_src.set_rrfilt (10);
+		alloc_src_buffer ();
 	}
-	_src.reset ();
+	_src_stale = true;
 }
 
 AudioBuffer&
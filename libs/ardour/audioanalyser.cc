@@ -20,12 +20,15 @@
  */
 
 #include <cstring>
+#include <sstream>
 
 #include <vamp-hostsdk/PluginLoader.h>
 
 #include "pbd/gstdio_compat.h"
+#include <glibmm/checksum.h>
 #include <glibmm/miscutils.h>
 #include <glibmm/fileutils.h>
+#include <glibmm/threads.h>
 
 #include "pbd/error.h"
 #include "pbd/failed_constructor.h"
@@ -64,6 +67,10 @@ AudioAnalyser::initialize_plugin (AnalysisPluginKey key, float sr)
 {
 	using namespace Vamp::HostExt;
 
+	/* analysis may run concurrently in several Analyser threads */
+	static Glib::Threads::Mutex loader_lock;
+	Glib::Threads::Mutex::Lock lm (loader_lock);
+
 	PluginLoader* loader (PluginLoader::getInstance());
 
 	plugin = loader->loadPlugin (key, sr, PluginLoader::ADAPT_ALL_SAFE);
@@ -101,6 +108,22 @@ AudioAnalyser::reset ()
 	}
 }
 
+string
+AudioAnalyser::analysis_key () const
+{
+	stringstream ss;
+	ss << plugin_key << ':' << sample_rate << ':' << stepsize << ':' << bufsize;
+
+	if (plugin) {
+		Plugin::ParameterList pl = plugin->getParameterDescriptors ();
+		for (Plugin::ParameterList::const_iterator i = pl.begin (); i != pl.end (); ++i) {
+			ss << ':' << i->identifier << '=' << plugin->getParameter (i->identifier);
+		}
+	}
+
+	return Glib::Checksum::compute_checksum (Glib::Checksum::CHECKSUM_MD5, ss.str ());
+}
+
 int
 AudioAnalyser::analyse (const string& path, AudioReadable* src, uint32_t channel)
 {
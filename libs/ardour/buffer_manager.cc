@@ -21,6 +21,7 @@
 #include <iostream>
 
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 
 #include "ardour/buffer_manager.h"
 #include "ardour/thread_buffers.h"
@@ -31,6 +32,7 @@ using namespace PBD;
 RingBufferNPT<ThreadBuffers*>* BufferManager::thread_buffers      = 0;
 std::list<ThreadBuffers*>*     BufferManager::thread_buffers_list = 0;
 Glib::Threads::Mutex           BufferManager::rb_mutex;
+std::vector<int>               BufferManager::cpu_numa_node;
 
 using std::cerr;
 using std::endl;
@@ -41,6 +43,23 @@ BufferManager::init (uint32_t size)
 	thread_buffers      = new ThreadBufferFIFO (size + 1); // must be one larger than requested
 	thread_buffers_list = new ThreadBufferList;
 
+	/* map CPUs to memory nodes, if there is more than one node */
+	std::vector<PBD::CPUCore> topo (PBD::cpu_topology ());
+	bool                      numa = false;
+	for (std::vector<PBD::CPUCore>::const_iterator c = topo.begin (); c != topo.end (); ++c) {
+		numa |= c->numa_node != topo.front ().numa_node;
+	}
+
+	cpu_numa_node.clear ();
+	if (numa) {
+		for (std::vector<PBD::CPUCore>::const_iterator c = topo.begin (); c != topo.end (); ++c) {
+			if ((size_t)c->cpu >= cpu_numa_node.size ()) {
+				cpu_numa_node.resize (c->cpu + 1, -1);
+			}
+			cpu_numa_node[c->cpu] = c->numa_node;
+		}
+	}
+
 	/* and populate with actual ThreadBuffers */
 
 	for (uint32_t n = 0; n < size; ++n) {
@@ -51,14 +70,23 @@ BufferManager::init (uint32_t size)
 	// cerr << "Initialized thread buffers, readable count now " << thread_buffers->read_space() << endl;
 }
 
+/** @param local re-allocate the buffers on the memory node of the calling
+ * thread, if needed. This is not realtime safe, and intended for threads
+ * that acquire buffers once, before they start processing.
+ */
 ThreadBuffers*
-BufferManager::get_thread_buffers ()
+BufferManager::get_thread_buffers (bool local)
 {
 	Glib::Threads::Mutex::Lock em (rb_mutex);
 	ThreadBuffers*             tbp;
 
 	if (thread_buffers->read (&tbp, 1) == 1) {
 		// cerr << "Got thread buffers, readable count now " << thread_buffers->read_space() << endl;
+		int node = local ? current_numa_node () : -1;
+		if (node >= 0 && node != tbp->numa_node) {
+			tbp->reallocate ();
+			tbp->numa_node = node;
+		}
 		return tbp;
 	}
 
@@ -78,7 +106,34 @@ BufferManager::ensure_buffers (ChanCount howmany, size_t custom)
 {
 	/* this is protected by the audioengine's process lock: we do not  */
 
+	Glib::Threads::Mutex::Lock em (rb_mutex);
+
+	/* Buffers are (re)allocated by this thread, and placed on its memory
+	 * node. Buffers that are not in use are re-allocated by the thread
+	 * that acquires them next. Buffers that are in use remain where they
+	 * are until their thread is restarted, (usually the engine is
+	 * restarted when the buffer-size changes).
+	 */
+	int node = current_numa_node ();
+
 	for (ThreadBufferList::iterator i = thread_buffers_list->begin (); i != thread_buffers_list->end (); ++i) {
 		(*i)->ensure_buffers (howmany, custom);
+		(*i)->numa_node = node;
+	}
+}
+
+/** @return the memory node of the CPU that the calling thread runs on,
+ * or -1 if unknown or if there is only one memory node.
+ */
+int
+BufferManager::current_numa_node ()
+{
+	if (cpu_numa_node.empty ()) {
+		return -1;
+	}
+	int cpu = PBD::current_cpu ();
+	if (cpu < 0 || (size_t)cpu >= cpu_numa_node.size ()) {
+		return -1;
 	}
+	return cpu_numa_node[cpu];
 }
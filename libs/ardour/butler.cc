@@ -57,11 +57,9 @@ Butler::Butler (Session& s)
 	, _audio_capture_buffer_size (0)
 	, _audio_playback_buffer_size (0)
 	, _midi_buffer_size (0)
-	, pool_trash (16)
 	, _xthread (true)
 {
 	should_do_transport_work.store (0);
-	SessionEvent::pool->set_trash (&pool_trash);
 
 	/* catch future changes to parameters */
 	Config->ParameterChanged.connect_same_thread (*this, boost::bind (&Butler::config_changed, this, _1));
@@ -327,8 +325,8 @@ Butler::thread_work ()
 			paused.signal ();
 		}
 
-		DEBUG_TRACE (DEBUG::Butler, "butler emptying pool trash\n");
-		empty_pool_trash ();
+		DEBUG_TRACE (DEBUG::Butler, "butler refills event pool\n");
+		SessionEvent::refill_pool ();
 		process_delegated_work ();
 	}
 
@@ -437,36 +435,6 @@ Butler::transport_work_requested () const
 	return should_do_transport_work.load ();
 }
 
-void
-Butler::empty_pool_trash ()
-{
-	/* look in the trash, deleting empty pools until we come to one that is not empty */
-
-	RingBuffer<CrossThreadPool*>::rw_vector vec;
-	pool_trash.get_read_vector (&vec);
-
-	guint deleted = 0;
-
-	for (int i = 0; i < 2; ++i) {
-		for (guint j = 0; j < vec.len[i]; ++j) {
-			if (vec.buf[i][j]->empty ()) {
-				delete vec.buf[i][j];
-				++deleted;
-			} else {
-				/* found a non-empty pool, so stop deleting */
-				if (deleted) {
-					pool_trash.increment_read_idx (deleted);
-				}
-				return;
-			}
-		}
-	}
-
-	if (deleted) {
-		pool_trash.increment_read_idx (deleted);
-	}
-}
-
 void
 Butler::process_delegated_work ()
 {
@@ -479,7 +447,6 @@ Butler::process_delegated_work ()
 void
 Butler::drop_references ()
 {
-	SessionEvent::pool->set_trash (0);
 	process_delegated_work ();
 }
 
@@ -18,8 +18,17 @@
 
 #include <assert.h>
 
+#include <atomic>
+#include <map>
+#include <sstream>
+
+#include <glibmm/threads.h>
+
+#include "pbd/cpus.h"
 #include "pbd/error.h"
+#include "pbd/mpmc_queue.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/semutils.h"
 
 #include "ardour/audio_buffer.h"
 #include "ardour/audioengine.h"
@@ -27,6 +36,7 @@
 #include "ardour/chan_mapping.h"
 #include "ardour/convolver.h"
 #include "ardour/dsp_filter.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/readable.h"
 #include "ardour/session.h"
 #include "ardour/source_factory.h"
@@ -39,6 +49,173 @@ using namespace ARDOUR;
 using namespace ARDOUR::DSP;
 using namespace ArdourZita;
 
+namespace ARDOUR {
+
+/** Process the non-uniform partitions of all Convolution instances
+ * using a shared pool of realtime threads.
+ *
+ * By default zita-convolver starts one thread per partition-size
+ * for every instance. Here a job is queued per partition-size and
+ * idle threads always pick the smallest pending partition first,
+ * since its deadline is closest.
+ */
+class ConvolverScheduler : public Convsched
+{
+public:
+	static ConvolverScheduler* acquire ();
+	static void                release ();
+	static uint32_t            overruns () { return _overruns.load (); }
+
+	void schedule (Convlevel*);
+
+private:
+	ConvolverScheduler ();
+	~ConvolverScheduler ();
+
+	static void* _thread (void*);
+	void         run ();
+
+	enum {
+		/* one queue per partition-size 64 .. 8192 */
+		N_QUEUES = 8
+	};
+
+	PBD::MPMCQueue<Convlevel*> _queue[N_QUEUES];
+	PBD::Semaphore             _sem;
+	std::vector<pthread_t>     _threads;
+	std::atomic<bool>          _exit;
+
+	static Glib::Threads::Mutex  _instance_lock;
+	static ConvolverScheduler*   _instance;
+	static uint32_t              _users;
+	static std::atomic<uint32_t> _overruns;
+};
+
+} // namespace ARDOUR
+
+Glib::Threads::Mutex  ConvolverScheduler::_instance_lock;
+ConvolverScheduler*   ConvolverScheduler::_instance = 0;
+uint32_t              ConvolverScheduler::_users = 0;
+std::atomic<uint32_t> ConvolverScheduler::_overruns (0);
+
+ConvolverScheduler*
+ConvolverScheduler::acquire ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	if (!_instance) {
+		_instance = new ConvolverScheduler;
+	}
+	++_users;
+	return _instance;
+}
+
+void
+ConvolverScheduler::release ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	assert (_users > 0);
+	if (--_users == 0) {
+		delete _instance;
+		_instance = 0;
+	}
+}
+
+ConvolverScheduler::ConvolverScheduler ()
+	: _sem (string_compose ("convolver_scheduler%1", this).c_str (), 0)
+	, _exit (false)
+{
+	for (int i = 0; i < N_QUEUES; ++i) {
+		_queue[i].reserve (256);
+	}
+
+	/* tail partitions are not time critical within a cycle, but in total
+	 * are the bulk of the work. leave some headroom for the process-graph.
+	 */
+	uint32_t n_threads = std::max<uint32_t> (1, std::min<uint32_t> (8, hardware_concurrency () / 2));
+	int      priority  = AudioEngine::instance ()->client_real_time_priority () - 1;
+
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		pthread_t tid;
+		if (pbd_realtime_pthread_create (PBD_SCHED_FIFO, priority, PBD_RT_STACKSIZE_HELP, &tid, _thread, this)) {
+			if (pbd_pthread_create (PBD_RT_STACKSIZE_HELP, &tid, _thread, this)) {
+				PBD::error << _("Convolver: cannot create worker thread") << endmsg;
+				continue;
+			}
+		}
+		_threads.push_back (tid);
+	}
+}
+
+ConvolverScheduler::~ConvolverScheduler ()
+{
+	_exit = true;
+	for (size_t i = 0; i < _threads.size (); ++i) {
+		_sem.signal ();
+	}
+	for (std::vector<pthread_t>::const_iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		pthread_join (*i, NULL);
+	}
+}
+
+void*
+ConvolverScheduler::_thread (void* arg)
+{
+	pthread_set_name ("ConvolverSched");
+	static_cast<ConvolverScheduler*> (arg)->run ();
+	return 0;
+}
+
+void
+ConvolverScheduler::schedule (Convlevel* L)
+{
+	uint32_t q = 0;
+	for (uint32_t p = parsize (L); p > Convproc::MINPART && q < N_QUEUES - 1; p >>= 1) {
+		++q;
+	}
+
+	if (_threads.empty ()) {
+		/* no worker thread, process in the calling thread */
+		Convsched::run (L);
+		return;
+	}
+
+	if (!_queue[q].push_back (L)) {
+		/* The workers are too late, processing the partition in the
+		 * calling (realtime) thread would only make matters worse.
+		 * Drop it, its contribution to the output is silent.
+		 */
+		_overruns.fetch_add (1);
+		Convsched::skip (L);
+		return;
+	}
+	_sem.signal ();
+}
+
+void
+ConvolverScheduler::run ()
+{
+	while (true) {
+		_sem.wait ();
+		if (_exit.load ()) {
+			break;
+		}
+		/* one job per signal, smallest partition first */
+		Convlevel* L;
+		for (int i = 0; i < N_QUEUES; ++i) {
+			if (_queue[i].pop_front (L)) {
+				Convsched::run (L);
+				break;
+			}
+		}
+	}
+}
+
+/* ****************************************************************************/
+
+/* IR spectra shared by Convolution instances with identical IR and configuration */
+static Glib::Threads::Mutex                            _ir_cache_lock;
+static std::map<std::string, std::weak_ptr<Convproc> > _ir_cache;
+
 Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     : SessionHandleRef (session)
     , _n_samples (0)
@@ -46,12 +223,26 @@ Convolution::Convolution (Session& session, uint32_t n_in, uint32_t n_out)
     , _offset (0)
     , _configured (false)
     , _threaded (false)
+    , _min_part (0)
+    , _max_part (0)
+    , _density (0)
+    , _sched (0)
     , _n_inputs (n_in)
     , _n_outputs (n_out)
 {
 	AudioEngine::instance ()->BufferSizeChanged.connect_same_thread (*this, boost::bind (&Convolution::restart, this));
 }
 
+Convolution::~Convolution ()
+{
+	_convproc.stop_process ();
+	_convproc.cleanup ();
+	_shared_ir.reset ();
+	if (_sched) {
+		ConvolverScheduler::release ();
+	}
+}
+
 bool
 Convolution::add_impdata (
     uint32_t                    c_in,
@@ -80,36 +271,68 @@ Convolution::clear_impdata ()
 	_impdata.clear ();
 }
 
+void
+Convolution::set_partitioning (uint32_t min_part, uint32_t max_part, float density)
+{
+	_min_part = min_part;
+	_max_part = max_part;
+	_density  = std::max (0.f, std::min (1.f, density));
+}
+
 bool
 Convolution::ready () const
 {
 	return _configured && _convproc.state () == Convproc::ST_PROC;
 }
 
+uint32_t
+Convolution::scheduler_overruns ()
+{
+	return ConvolverScheduler::overruns ();
+}
+
+static uint32_t
+ceil_power_of_two (uint32_t n)
+{
+	uint32_t power_of_two;
+	for (power_of_two = 1; 1U << power_of_two < n; ++power_of_two) ;
+	return 1U << power_of_two;
+}
+
 void
 Convolution::restart ()
 {
 	_convproc.stop_process ();
 	_convproc.cleanup ();
 	_convproc.set_options (0);
+	_shared_ir.reset ();
 
 	if (_impdata.empty ()) {
 		_configured = false;
 		return;
 	}
 
-	uint32_t n_part;
+	uint32_t min_part;
+	uint32_t max_part;
 
 	if (_threaded) {
 		_n_samples = 64;
-		n_part     = Convproc::MAXPART;
+		max_part   = Convproc::MAXPART;
 	} else {
-		_n_samples = _session.get_block_size ();
-		uint32_t power_of_two;
-		for (power_of_two = 1; 1U << power_of_two < _n_samples; ++power_of_two) ;
-		_n_samples = 1 << power_of_two;
-		n_part     = std::min ((uint32_t)Convproc::MAXPART, _n_samples);
+		_n_samples = ceil_power_of_two (_session.get_block_size ());
+		max_part   = std::min ((uint32_t)Convproc::MAXPART, _n_samples);
+	}
+
+	min_part = std::max ((uint32_t)Convproc::MINPART, _n_samples);
+
+	if (_min_part > 0) {
+		min_part = std::max (min_part, std::min (16 * _n_samples, ceil_power_of_two (_min_part)));
+		min_part = std::min ((uint32_t)Convproc::MAXPART, min_part);
+	}
+	if (_max_part > 0) {
+		max_part = std::min ((uint32_t)Convproc::MAXPART, ceil_power_of_two (_max_part));
 	}
+	max_part = std::max (min_part, max_part);
 
 	_offset    = 0;
 	_max_size  = 0;
@@ -123,9 +346,52 @@ Convolution::restart ()
 	    /*out*/ _n_outputs,
 	    /*max-convolution length */ _max_size,
 	    /*quantum, nominal-buffersize*/ _n_samples,
-	    /*Convproc::MINPART*/ _n_samples,
-	    /*Convproc::MAXPART*/ n_part,
-	    /*density 0 = auto, i/o dependent */ 0);
+	    /*Convproc::MINPART*/ min_part,
+	    /*Convproc::MAXPART*/ max_part,
+	    /*density 0 = auto, i/o dependent */ _density);
+
+	if (rv == 0) {
+		if (_ir_key.empty ()) {
+			rv = create_impdata (_convproc);
+		} else {
+			rv = share_impdata (min_part, max_part);
+		}
+	}
+
+	if (Config->get_convolver_thread_pool ()) {
+		if (!_sched) {
+			_sched = ConvolverScheduler::acquire ();
+		}
+	} else if (_sched) {
+		ConvolverScheduler::release ();
+		_sched = 0;
+	}
+
+	if (rv == 0) {
+		rv = _convproc.start_process (pbd_absolute_rt_priority (PBD_SCHED_FIFO, AudioEngine::instance ()->client_real_time_priority () - 1), PBD_SCHED_FIFO, _sched);
+	}
+
+	assert (rv == 0); // bail out in debug builds
+
+	if (rv != 0) {
+		_convproc.stop_process ();
+		_convproc.cleanup ();
+		_shared_ir.reset ();
+		_configured = false;
+		return;
+	}
+
+	_configured = true;
+
+#ifndef NDEBUG
+	_convproc.print (stdout);
+#endif
+}
+
+int
+Convolution::create_impdata (Convproc& convproc)
+{
+	int rv = 0;
 
 	for (std::vector<ImpData>::const_iterator i = _impdata.begin (); i != _impdata.end (); ++i) {
 		uint32_t pos = 0;
@@ -150,14 +416,14 @@ Convolution::restart ()
 				}
 			}
 
-			rv = _convproc.impdata_create (
+			rv = convproc.impdata_create (
 			    /*i/o map */ i->c_in, i->c_out,
 			    /*stride, de-interleave */ 1,
 			    ir,
 			    ir_delay + pos, ir_delay + pos + ns);
 
 			if (rv != 0) {
-				break;
+				return rv;
 			}
 
 			pos += ns;
@@ -167,25 +433,46 @@ Convolution::restart ()
 			}
 		}
 	}
+	return rv;
+}
 
-	if (rv == 0) {
-		rv = _convproc.start_process (pbd_absolute_rt_priority (PBD_SCHED_FIFO, AudioEngine::instance ()->client_real_time_priority () - 1), PBD_SCHED_FIFO);
-	}
+int
+Convolution::share_impdata (uint32_t min_part, uint32_t max_part)
+{
+	/* the partitioning must match for spectra to be shared */
+	std::stringstream ss;
+	ss << _ir_key << "|" << _n_inputs << "x" << _n_outputs
+	   << "|" << _max_size << "|" << _n_samples
+	   << "|" << min_part << "-" << max_part << "|" << _density;
 
-	assert (rv == 0); // bail out in debug builds
+	Glib::Threads::Mutex::Lock lm (_ir_cache_lock);
 
-	if (rv != 0) {
-		_convproc.stop_process ();
-		_convproc.cleanup ();
-		_configured = false;
-		return;
+	for (std::map<std::string, std::weak_ptr<Convproc> >::iterator i = _ir_cache.begin (); i != _ir_cache.end ();) {
+		if (i->second.expired ()) {
+			_ir_cache.erase (i++);
+		} else {
+			++i;
+		}
 	}
 
-	_configured = true;
+	std::shared_ptr<Convproc> ir = _ir_cache[ss.str ()].lock ();
 
-#ifndef NDEBUG
-	_convproc.print (stdout);
-#endif
+	if (!ir) {
+		ir.reset (new Convproc);
+		ir->set_options (0);
+		int rv = ir->configure (_n_inputs, _n_outputs, _max_size, _n_samples, min_part, max_part, _density);
+		if (rv == 0) {
+			rv = create_impdata (*ir);
+		}
+		if (rv != 0) {
+			_ir_cache.erase (ss.str ());
+			return rv;
+		}
+		_ir_cache[ss.str ()] = ir;
+	}
+
+	_shared_ir = ir;
+	return _convproc.impdata_share (ir.get ());
 }
 
 void
@@ -235,6 +522,103 @@ Convolution::run (BufferSet& bufs, ChanMapping const& in_map, ChanMapping const&
 
 /* ****************************************************************************/
 
+namespace {
+
+/** Decoded and resampled IR channel, immutable once loaded */
+class DecodedIR : public AudioReadable
+{
+public:
+	DecodedIR (std::shared_ptr<AudioReadable> r)
+	{
+		samplecnt_t len = r->readable_length_samples ();
+		_data.resize (len);
+
+		samplecnt_t pos = 0;
+		while (pos < len) {
+			samplecnt_t ns = r->read (&_data[pos], pos, std::min<samplecnt_t> (8192, len - pos), 0);
+			if (ns <= 0) {
+				break;
+			}
+			pos += ns;
+		}
+		_data.resize (pos);
+	}
+
+	samplecnt_t read (Sample* s, samplepos_t pos, samplecnt_t cnt, int channel) const {
+		if (pos >= (samplepos_t)_data.size ()) {
+			return 0;
+		}
+		cnt = std::min<samplecnt_t> (cnt, _data.size () - pos);
+		memcpy (s, &_data[pos], sizeof (Sample) * cnt);
+		return cnt;
+	}
+
+	samplecnt_t readable_length_samples () const { return _data.size (); }
+	uint32_t    n_channels () const { return 1; }
+
+private:
+	std::vector<Sample> _data;
+};
+
+}
+
+/* Decoded IR files, by path and sample-rate */
+static Glib::Threads::Mutex                                                _decoded_ir_lock;
+static std::map<std::string, std::vector<std::weak_ptr<AudioReadable> > > _decoded_ir;
+
+/** Load and resample the given IR file once, and share the result
+ * with all Convolver instances that use it.
+ */
+static std::vector<std::shared_ptr<AudioReadable> >
+load_decoded_ir (Session& session, std::string const& path)
+{
+	std::vector<std::shared_ptr<AudioReadable> > readables;
+
+	std::string const key = string_compose ("%1|%2", path, session.nominal_sample_rate ());
+
+	/* hold the lock while decoding, concurrent instances wait for the data */
+	Glib::Threads::Mutex::Lock lm (_decoded_ir_lock);
+
+	for (std::map<std::string, std::vector<std::weak_ptr<AudioReadable> > >::iterator i = _decoded_ir.begin (); i != _decoded_ir.end ();) {
+		if (i->second.empty () || i->second.front ().expired ()) {
+			_decoded_ir.erase (i++);
+		} else {
+			++i;
+		}
+	}
+
+	std::map<std::string, std::vector<std::weak_ptr<AudioReadable> > >::const_iterator i = _decoded_ir.find (key);
+	if (i != _decoded_ir.end ()) {
+		for (std::vector<std::weak_ptr<AudioReadable> >::const_iterator r = i->second.begin (); r != i->second.end (); ++r) {
+			std::shared_ptr<AudioReadable> ar = r->lock ();
+			if (!ar) {
+				readables.clear ();
+				break;
+			}
+			readables.push_back (ar);
+		}
+		if (!readables.empty ()) {
+			return readables;
+		}
+	}
+
+	readables = AudioReadable::load (session, path);
+
+	if (readables.empty () || readables[0]->readable_length_samples () > 0x1000000 /*2^24*/) {
+		/* leave it to the caller to report the error */
+		return readables;
+	}
+
+	std::vector<std::weak_ptr<AudioReadable> > cached;
+	for (std::vector<std::shared_ptr<AudioReadable> >::iterator r = readables.begin (); r != readables.end (); ++r) {
+		*r = std::shared_ptr<AudioReadable> (new DecodedIR (*r));
+		cached.push_back (*r);
+	}
+	_decoded_ir[key] = cached;
+
+	return readables;
+}
+
 Convolver::Convolver (
     Session&           session,
     std::string const& path,
@@ -246,7 +630,7 @@ Convolver::Convolver (
 {
 	_threaded = true;
 
-	std::vector<std::shared_ptr<AudioReadable> > readables = AudioReadable::load (_session, path);
+	std::vector<std::shared_ptr<AudioReadable> > readables = load_decoded_ir (_session, path);
 
 	if (readables.empty ()) {
 		PBD::error << string_compose (_("Convolver: IR \"%1\" no usable audio-channels sound."), path) << endmsg;
@@ -321,6 +705,14 @@ Convolver::Convolver (
 		add_impdata (io_i, io_o, r, chan_gain, chan_delay);
 	}
 
+	/* instances using the same file and settings share the IR spectra */
+	std::stringstream ss;
+	ss << path << "|" << (int)_irc << "|" << _ir_settings.gain << "|" << _ir_settings.pre_delay;
+	for (uint32_t c = 0; c < 4; ++c) {
+		ss << "|" << _ir_settings.channel_gain[c] << "|" << _ir_settings.channel_delay[c];
+	}
+	_ir_key = ss.str ();
+
 	Convolution::restart ();
 }
 
@@ -107,8 +107,14 @@ FFMPEGFileImportableSource::~FFMPEGFileImportableSource ()
 void
 FFMPEGFileImportableSource::seek (samplepos_t pos)
 {
-	if (pos < _read_pos) {
+	/* Rather than decoding (and discarding) everything from the
+	 * start of the file or the current read position, restart the
+	 * decoder at the target position. This is only worth it for
+	 * larger distances. Short forward seeks simply skip ahead.
+	 */
+	if (pos < _read_pos || pos > _read_pos + _samplerate) {
 		reset ();
+		start_ffmpeg (pos);
 	}
 
 	if (!_ffmpeg_exec) {
@@ -161,7 +167,7 @@ FFMPEGFileImportableSource::read (Sample* dst, samplecnt_t nframes)
 }
 
 void
-FFMPEGFileImportableSource::start_ffmpeg ()
+FFMPEGFileImportableSource::start_ffmpeg (samplepos_t start)
 {
 	std::string ffmpeg_exe, unused;
 	ArdourVideoToolPaths::transcoder_exe (ffmpeg_exe, unused);
@@ -171,6 +177,16 @@ FFMPEGFileImportableSource::start_ffmpeg ()
 	char   tmp[32];
 	argp[a++] = strdup (ffmpeg_exe.c_str ());
 	argp[a++] = strdup ("-nostdin");
+	if (start > 0 && _samplerate > 0) {
+		/* input seeking, ffmpeg decodes and drops samples before the
+		 * given position (-accurate_seek is enabled by default).
+		 * Timestamps have microsecond resolution, which is
+		 * sufficient to be sample-accurate up to 1MHz.
+		 */
+		argp[a++] = strdup ("-ss");
+		snprintf (tmp, sizeof (tmp), "%.6f", start / (double)_samplerate);
+		argp[a++] = strdup (tmp);
+	}
 	argp[a++] = strdup ("-i");
 	argp[a++] = strdup (_path.c_str ());
 	if (_channel != ALL_CHANNELS) {
@@ -194,6 +210,7 @@ FFMPEGFileImportableSource::start_ffmpeg ()
 	}
 
 	_ffmpeg_exec->ReadStdout.connect_same_thread (_ffmpeg_conn, boost::bind (&FFMPEGFileImportableSource::did_read_data, this, _1, _2));
+	_read_pos = start;
 }
 
 void
@@ -39,9 +39,13 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
+Glib::Threads::Mutex Filter::_source_lock;
+
 int
 Filter::make_new_sources (std::shared_ptr<Region> region, SourceList& nsrcs, std::string suffix, bool use_session_sample_rate)
 {
+	Glib::Threads::Mutex::Lock lm (_source_lock);
+
 	vector<string> names = region->master_source_names();
 	const SourceList::size_type nsrc = region->sources().size();
 	assert (nsrc <= names.size());
@@ -98,6 +102,8 @@ Filter::make_new_sources (std::shared_ptr<Region> region, SourceList& nsrcs, std
 int
 Filter::finish (std::shared_ptr<Region> region, SourceList& nsrcs, string region_name)
 {
+	Glib::Threads::Mutex::Lock lm (_source_lock);
+
 	/* update headers on new sources */
 
 	time_t xnow;
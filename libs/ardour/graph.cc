@@ -21,10 +21,17 @@
  */
 
 #include <cmath>
+#include <map>
 #include <stdio.h>
 
+#if defined _MSC_VER && (defined _M_IX86 || defined _M_X64)
+#include <immintrin.h>
+#endif
+
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/debug_rt_alloc.h"
+#include "pbd/microseconds.h"
 #include "pbd/pthread_utils.h"
 
 #include "temporal/superclock.h"
@@ -35,6 +42,7 @@
 #include "ardour/graph.h"
 #include "ardour/io_plug.h"
 #include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/route.h"
 #include "ardour/rt_task.h"
 #include "ardour/rt_tasklist.h"
@@ -60,6 +68,9 @@ alloc_allowed ()
 }
 #endif
 
+/* the graph that the calling thread is a worker of */
+static thread_local Graph* worker_of_graph = 0;
+
 Graph::Graph (Session& session)
 	: SessionHandleRef (session)
 	, _execution_sem ("graph_execution", 0)
@@ -73,6 +84,16 @@ Graph::Graph (Session& session)
 	_n_workers.store (0);
 	_idle_thread_cnt.store (0);
 	_trigger_queue_size.store (0);
+	_nested_tasklist.store (0);
+	_nested_users.store (0);
+	_spin_usecs.store (0);
+	_n_cycles.store (0);
+	_n_spin_wakeups.store (0);
+	_n_sleep_wakeups.store (0);
+	_affinity_domain.store (-1);
+	_affinity_generation.store (0);
+	_affinity_change_count = 0;
+	_affinity_applied      = 0;
 
 	/* pre-allocate memory */
 	_trigger_queue.reserve (1024);
@@ -121,6 +142,8 @@ Graph::reset_thread_list ()
 		drop_threads ();
 	}
 
+	setup_affinity (num_threads);
+
 	/* Allow threads to run */
 	_terminate.store (0);
 
@@ -218,6 +241,8 @@ Graph::prep ()
 		_trigger_queue.reserve (_graph_chain->_nodes_rt.size ());
 	}
 
+	_spin_usecs.store (_session.config.get_graph_worker_spin_usecs ());
+
 	_terminal_refcnt.store (_graph_chain->_n_terminal_nodes);
 
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
@@ -248,6 +273,8 @@ Graph::reached_terminal_node ()
 		 */
 		assert (_trigger_queue_size.load() == 0);
 
+		_n_cycles.fetch_add (1, std::memory_order_relaxed);
+
 		/* Notify caller */
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 cycle done.\n", pthread_name ()));
 
@@ -263,6 +290,9 @@ Graph::reached_terminal_node ()
 			sched_yield ();
 		}
 
+		/* all other process threads are parked, move them if needed */
+		repin_threads ();
+
 		/* Block until the a process callback */
 		_callback_start_sem.wait ();
 
@@ -285,9 +315,248 @@ Graph::reached_terminal_node ()
 	}
 }
 
+static inline void
+cpu_relax ()
+{
+#if defined __i386__ || defined __x86_64__
+	__builtin_ia32_pause ();
+#elif defined _MSC_VER && (defined _M_IX86 || defined _M_X64)
+	_mm_pause ();
+#elif defined __aarch64__ || defined __arm__
+	__asm__ __volatile__ ("yield");
+#endif
+}
+
+/** Block until another thread signals _execution_sem.
+ *
+ * If enabled, first spin for a short while, to avoid the
+ * latency of a context switch when work is passed on to
+ * this thread in the same cycle. The spin-time is reduced
+ * when spinning is in vain (e.g. while waiting for the next
+ * cycle), and restored when spinning succeeds.
+ *
+ * @param spin_budget per thread state, max spin time [usec]
+ */
+void
+Graph::wait_for_work (uint32_t& spin_budget)
+{
+	uint32_t const max_spin = _spin_usecs.load ();
+	uint32_t const spin     = std::min (spin_budget, max_spin);
+
+	if (spin > 0) {
+		microseconds_t const until = PBD::get_microseconds () + spin;
+		do {
+			for (int i = 0; i < 64; ++i) {
+				if (_execution_sem.try_wait ()) {
+					spin_budget = max_spin;
+					_n_spin_wakeups.fetch_add (1, std::memory_order_relaxed);
+					return;
+				}
+				cpu_relax ();
+			}
+		} while (PBD::get_microseconds () < until);
+
+		spin_budget = std::max (spin / 2, std::max<uint32_t> (1, max_spin / 8));
+	}
+
+	_execution_sem.wait ();
+	_n_sleep_wakeups.fetch_add (1, std::memory_order_relaxed);
+}
+
+GraphWakeupStats
+Graph::wakeup_stats () const
+{
+	GraphWakeupStats s;
+	s.cycles = _n_cycles.load ();
+	s.spins  = _n_spin_wakeups.load ();
+	s.sleeps = _n_sleep_wakeups.load ();
+	return s;
+}
+
+void
+Graph::reset_wakeup_stats ()
+{
+	_n_cycles.store (0);
+	_n_spin_wakeups.store (0);
+	_n_sleep_wakeups.store (0);
+}
+
+/** Prepare CPU sets for pinning process threads.
+ *
+ * Process threads are kept on CPUs that share the last level cache
+ * with the backend's process thread, which calls into the graph.
+ * If there are fewer such CPUs than process threads, the CPUs of
+ * the same NUMA node, or all CPUs are used.
+ *
+ * Must not be called while process threads are running.
+ */
+void
+Graph::setup_affinity (uint32_t n_threads)
+{
+	_cpu_domains.clear ();
+	_cpu_domain_of.clear ();
+	_affinity_domain.store (-1);
+	_affinity_generation.store (0);
+	_affinity_change_count = 0;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_affinity_lock);
+		_affinity_threads.clear ();
+		_affinity_applied = 0;
+	}
+
+	if (!Config->get_pin_process_threads ()) {
+		return;
+	}
+
+	std::vector<PBD::CPUCore> topo (PBD::cpu_topology ());
+	if (topo.empty ()) {
+		DEBUG_TRACE (DEBUG::ProcessThreads, "CPU topology is not available, process threads are not pinned\n");
+		return;
+	}
+
+	bool avoid_smt = Config->get_process_threads_avoid_smt ();
+
+	std::map<int, std::vector<int> > by_l3;
+	std::map<int, std::vector<int> > by_node;
+	std::vector<int>                 all;
+	int                              max_cpu = 0;
+
+	for (auto const& c : topo) {
+		max_cpu = std::max (max_cpu, c.cpu);
+		if (avoid_smt && c.smt_sibling) {
+			continue;
+		}
+		by_l3[c.l3].push_back (c.cpu);
+		by_node[c.numa_node].push_back (c.cpu);
+		all.push_back (c.cpu);
+	}
+
+	_cpu_domain_of.resize (max_cpu + 1, -1);
+
+	std::map<int, int> l3_domain;
+	for (auto const& c : topo) {
+		std::map<int, int>::const_iterator d = l3_domain.find (c.l3);
+		if (d != l3_domain.end ()) {
+			_cpu_domain_of[c.cpu] = d->second;
+			continue;
+		}
+		std::vector<int> cpus = by_l3[c.l3];
+		if (cpus.size () < n_threads) {
+			cpus = by_node[c.numa_node];
+		}
+		if (cpus.size () < n_threads) {
+			cpus = all;
+		}
+		_cpu_domain_of[c.cpu] = l3_domain[c.l3] = _cpu_domains.size ();
+		_cpu_domains.push_back (cpus);
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("CPU domain %1 (L3 of CPU %2) has %3 CPUs\n", _cpu_domains.size () - 1, c.l3, cpus.size ()));
+	}
+
+	/* Threads are pinned before they acquire their buffers (which are
+	 * placed on the memory node of the thread). The backend's process
+	 * thread is not known yet, start with the domain of the thread that
+	 * starts the engine. update_affinity () follows the backend later,
+	 * buffers then remain where they are until threads are restarted.
+	 */
+	int cpu = PBD::current_cpu ();
+	if (cpu >= 0 && cpu < (int)_cpu_domain_of.size () && _cpu_domain_of[cpu] >= 0) {
+		_affinity_domain.store (_cpu_domain_of[cpu]);
+	} else if (!_cpu_domains.empty ()) {
+		_affinity_domain.store (0);
+	}
+	/* threads are pinned to this domain when they register */
+	_affinity_generation.store (1);
+	_affinity_applied = 1;
+}
+
+/** Called by the backend's process thread, every cycle */
+void
+Graph::update_affinity ()
+{
+	if (_cpu_domains.empty ()) {
+		return;
+	}
+
+	int cpu = PBD::current_cpu ();
+	if (cpu < 0 || cpu >= (int)_cpu_domain_of.size () || _cpu_domain_of[cpu] < 0) {
+		return;
+	}
+
+	int d = _cpu_domain_of[cpu];
+	if (d == _affinity_domain.load ()) {
+		_affinity_change_count = 0;
+		return;
+	}
+
+	/* only follow the backend thread, if it was not just briefly moved */
+	if (++_affinity_change_count < 64) {
+		return;
+	}
+
+	_affinity_change_count = 0;
+	_affinity_domain.store (d);
+	_affinity_generation.fetch_add (1);
+}
+
+/** Called by process threads when they start, before they acquire
+ * their buffers. Pin the calling thread to the current domain.
+ */
+void
+Graph::register_affinity_thread ()
+{
+	Glib::Threads::Mutex::Lock lm (_affinity_lock);
+
+	_affinity_threads.push_back (pthread_self ());
+
+	int d = _affinity_domain.load ();
+	if (d < 0) {
+		return;
+	}
+
+	if (PBD::set_thread_cpu_affinity (pthread_self (), _cpu_domains[d])) {
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 failed to set CPU affinity\n", pthread_name ()));
+	} else {
+		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 uses CPU domain %2\n", pthread_name (), d));
+	}
+}
+
+/** Called by the process thread that completed a cycle, after all other
+ * process threads are idle, and before the next cycle starts: move all
+ * threads if the domain changed.
+ */
+void
+Graph::repin_threads ()
+{
+	uint32_t g = _affinity_generation.load ();
+	if (g == _affinity_applied) {
+		return;
+	}
+
+	/* a thread is registering, try again after the next cycle */
+	Glib::Threads::Mutex::Lock lm (_affinity_lock, Glib::Threads::TRY_LOCK);
+	if (!lm.locked ()) {
+		return;
+	}
+
+	_affinity_applied = g;
+
+	int d = _affinity_domain.load ();
+	if (d < 0) {
+		return;
+	}
+
+	for (auto const& t : _affinity_threads) {
+		if (PBD::set_thread_cpu_affinity (t, _cpu_domains[d])) {
+			DEBUG_TRACE (DEBUG::ProcessThreads, "failed to set CPU affinity of a process thread\n");
+		}
+	}
+	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 process threads use CPU domain %2\n", _affinity_threads.size (), d));
+}
+
 /** Called by both the main thread and all helpers. */
 void
-Graph::run_one ()
+Graph::run_one (uint32_t& spin_budget)
 {
 	ProcessNode* to_run = NULL;
 
@@ -317,7 +586,7 @@ Graph::run_one ()
 		assert (_idle_thread_cnt.load() <= _n_workers.load());
 
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name ()));
-		_execution_sem.wait ();
+		wait_for_work (spin_budget);
 
 		if (_terminate.load ()) {
 			return;
@@ -327,6 +596,9 @@ Graph::run_one ()
 
 		PBD::atomic_dec_and_test (_idle_thread_cnt);
 
+		/* A graph-node may have woken us to share its tasks */
+		help_nested ();
+
 		/* Try to find some work to do */
 		_trigger_queue.pop_front (to_run);
 	}
@@ -362,14 +634,19 @@ Graph::helper_thread ()
 		PBD::notify_event_loops_about_thread_creation (pthread_self (), name, 64);
 	}
 
+	worker_of_graph = this;
+
+	register_affinity_thread ();
+
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
+	/* place buffers on this thread's memory node */
+	pt->get_buffers (true);
 	resume_rt_malloc_checks ();
 
-	pt->get_buffers ();
-
+	uint32_t spin_budget = UINT32_MAX;
 	while (!_terminate.load ()) {
-		run_one ();
+		run_one (spin_budget);
 	}
 
 	pt->drop_buffers ();
@@ -394,9 +671,14 @@ Graph::main_thread ()
 		SessionEvent::create_per_thread_pool (name, 64);
 		PBD::notify_event_loops_about_thread_creation (pthread_self (), name, 64);
 	}
-	resume_rt_malloc_checks ();
 
-	pt->get_buffers ();
+	worker_of_graph = this;
+
+	register_affinity_thread ();
+
+	/* place buffers on this thread's memory node */
+	pt->get_buffers (true);
+	resume_rt_malloc_checks ();
 
 	/* Wait for initial process callback */
 again:
@@ -421,8 +703,9 @@ again:
 	}
 
 	/* After setup, the main-thread just becomes a normal worker */
+	uint32_t spin_budget = UINT32_MAX;
 	while (!_terminate.load ()) {
-		run_one ();
+		run_one (spin_budget);
 	}
 
 	pt->drop_buffers ();
@@ -447,6 +730,8 @@ Graph::process_routes (std::shared_ptr<GraphChain> chain, pframes_t nframes, sam
 	_process_retval      = 0;
 	_process_need_butler = false;
 
+	update_affinity ();
+
 	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for non-silent process\n");
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
@@ -476,6 +761,8 @@ Graph::routes_no_roll (std::shared_ptr<GraphChain> chain, pframes_t nframes, sam
 	_process_need_butler    = false;
 	_process_non_rt_pending = non_rt_pending;
 
+	update_affinity ();
+
 	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for no-roll process\n");
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
@@ -499,6 +786,8 @@ Graph::silence_routes (std::shared_ptr<GraphChain> chain, pframes_t nframes)
 	_process_retval      = 0;
 	_process_need_butler = false;
 
+	update_affinity ();
+
 	DEBUG_TRACE (DEBUG::ProcessThreads, "wake graph for silence process\n");
 	_callback_start_sem.signal ();
 	_callback_done_sem.wait ();
@@ -599,6 +888,66 @@ Graph::process_tasklist (RTTaskList const& rt)
 	DEBUG_TRACE (DEBUG::ProcessThreads, "graph execution complete\n");
 }
 
+bool
+Graph::process_nested_tasklist (RTTaskList& rt)
+{
+	/* Only graph-nodes that are processed by this graph's threads can
+	 * share work. Other callers (export, bounce, processing without a
+	 * graph) run outside of a graph cycle, and there are no idle
+	 * workers waiting for the nested tasks.
+	 * While a cycle is active, there is at least one terminal node
+	 * that has not completed.
+	 */
+	if (worker_of_graph != this || _terminal_refcnt.load () == 0) {
+		return false;
+	}
+
+	size_t n_tasks = rt._tasks.size ();
+	uint32_t idle  = _idle_thread_cnt.load ();
+
+	if (n_tasks < 2 || idle == 0) {
+		return false;
+	}
+
+	/* only one graph-node at a time can share its tasks */
+	RTTaskList* expected = 0;
+	rt._next.store (0);
+	if (!_nested_tasklist.compare_exchange_strong (expected, &rt)) {
+		return false;
+	}
+
+	uint32_t wakeup = std::min<uint32_t> (idle, n_tasks - 1);
+
+	DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 shares %2 tasks, signals %3 threads\n", pthread_name (), n_tasks, wakeup));
+	for (uint32_t i = 0; i < wakeup; ++i) {
+		_execution_sem.signal ();
+	}
+
+	/* participate, until all tasks have been claimed */
+	while (rt.run_next ()) ;
+
+	/* withdraw the list, and wait for helpers to complete the tasks they claimed */
+	_nested_tasklist.store (0);
+	while (_nested_users.load () > 0) {
+		sched_yield ();
+	}
+	return true;
+}
+
+void
+Graph::help_nested ()
+{
+	/* announce use before looking at the list, so that
+	 * process_nested_tasklist() can wait for us */
+	_nested_users.fetch_add (1);
+	RTTaskList* rt = _nested_tasklist.load ();
+	if (rt) {
+		Temporal::TempoMap::fetch ();
+		while (rt->run_next ()) ;
+	}
+	_nested_users.fetch_sub (1);
+}
+
 /* ****************************************************************************/
 
 GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
@@ -622,8 +971,14 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 
 	/* now add refs for the connections. */
 	for (auto const& ni : _nodes_rt) {
-		/* The nodes that are directly fed by ni */
-		set<GraphVertex> fed_from_r = edges.from (ni);
+		/* The nodes that are directly fed by ni,
+		 * except for pipelined nodes which use data from the previous cycle */
+		set<GraphVertex> fed_from_r;
+		for (auto const& i : edges.from (ni)) {
+			if (!i->pipelined ()) {
+				fed_from_r.insert (i);
+			}
+		}
 
 		/* Hence whether ni has an output, or is otherwise a terminal node */
 		bool const has_output = !fed_from_r.empty ();
@@ -644,7 +999,7 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 		}
 
 		/* ni has an input if there are some incoming edges to r in the graph */
-		bool const has_input = !edges.has_none_to (ni);
+		bool const has_input = !ni->pipelined () && !edges.has_none_to (ni);
 
 		if (!has_input) {
 			/* no input, so this node needs to be triggered initially to get things going */
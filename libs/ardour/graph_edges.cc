@@ -63,6 +63,19 @@ GraphEdges::find_in_from_to_with_sends (GraphVertex from, GraphVertex to)
 	return _from_to_with_sends.end ();
 }
 
+GraphEdges::EdgeMapWithSends::const_iterator
+GraphEdges::find_in_from_to_with_sends (GraphVertex from, GraphVertex to) const
+{
+	typedef EdgeMapWithSends::const_iterator Iter;
+	pair<Iter, Iter> r = _from_to_with_sends.equal_range (from);
+	for (Iter i = r.first; i != r.second; ++i) {
+		if (i->second.first == to) {
+			return i;
+		}
+	}
+	return _from_to_with_sends.end ();
+}
+
 GraphEdges::EdgeMapWithSends::iterator
 GraphEdges::find_in_to_from_with_sends (GraphVertex to, GraphVertex from)
 {
@@ -99,9 +112,9 @@ GraphEdges::find_recursively_in_from_to_with_sends (GraphVertex from, GraphVerte
  *  @return true if the given edge is present.
  */
 bool
-GraphEdges::has (GraphVertex from, GraphVertex to, bool* via_sends_only)
+GraphEdges::has (GraphVertex from, GraphVertex to, bool* via_sends_only) const
 {
-	EdgeMapWithSends::iterator i = find_in_from_to_with_sends (from, to);
+	EdgeMapWithSends::const_iterator i = find_in_from_to_with_sends (from, to);
 	if (i == _from_to_with_sends.end ()) {
 		return false;
 	}
@@ -176,6 +189,17 @@ GraphEdges::remove (GraphVertex from, GraphVertex to)
 	_from_to_with_sends.erase (k);
 }
 
+void
+GraphEdges::add_all_except (GraphEdges const& other, std::set<GraphVertex> const& skip)
+{
+	for (auto const& e : other._from_to_with_sends) {
+		if (skip.find (e.first) != skip.end () || skip.find (e.second.first) != skip.end ()) {
+			continue;
+		}
+		add (e.first, e.second.first, e.second.second);
+	}
+}
+
 /** @param to `To' route.
  *  @return true if there are no edges going to `to'.
  */
@@ -274,33 +298,12 @@ struct RouteRecEnabledComparator
 	}
 };
 
-/** Perform a topological sort of a list of routes using a directed graph representing connections.
- *  @return Sorted list of routes, or 0 if the graph contains cycles (feedback loops).
+/** Sort nodes according to the given edges (Kahn's algorithm).
+ *  @return false if the graph contains cycles (feedback loops).
  */
-bool
-ARDOUR::topological_sort (GraphNodeList& nodes, GraphEdges& edges)
+static bool
+sort_by_edges (GraphNodeList& nodes, GraphEdges const& edges)
 {
-	/* Collect the edges of the  graph.  Each of these edges
-	 * is a pair of nodes, one of which directly feeds the other
-	 * either by a port connection or by an internal send.
-	 */
-
-	for (auto const& i : nodes) {
-
-		for (auto const& j : nodes) {
-
-			bool via_sends_only = false;
-
-			/* See if this *j feeds *i according to the current state of
-			 * port connections and internal sends.
-			 */
-			if (j->direct_feeds_according_to_reality (i, &via_sends_only)) {
-				/* add the edge to the graph (part #1) */
-				edges.add (j, i, via_sends_only);
-			}
-		}
-	}
-
 	GraphNodeList queue;
 
 	/* initial queue has routes that are not fed by anything */
@@ -344,3 +347,70 @@ ARDOUR::topological_sort (GraphNodeList& nodes, GraphEdges& edges)
 
 	return true;
 }
+
+/** Perform a topological sort of a list of routes using a directed graph representing connections.
+ *  @return Sorted list of routes, or 0 if the graph contains cycles (feedback loops).
+ */
+bool
+ARDOUR::topological_sort (GraphNodeList& nodes, GraphEdges& edges)
+{
+	/* Collect the edges of the  graph.  Each of these edges
+	 * is a pair of nodes, one of which directly feeds the other
+	 * either by a port connection or by an internal send.
+	 */
+
+	for (auto const& i : nodes) {
+
+		for (auto const& j : nodes) {
+
+			bool via_sends_only = false;
+
+			/* See if this *j feeds *i according to the current state of
+			 * port connections and internal sends.
+			 */
+			if (j->direct_feeds_according_to_reality (i, &via_sends_only)) {
+				/* add the edge to the graph (part #1) */
+				edges.add (j, i, via_sends_only);
+			}
+		}
+	}
+
+	return sort_by_edges (nodes, edges);
+}
+
+/** Perform a topological sort after the connections of only a few nodes changed.
+ *
+ *  Edges between unchanged nodes are taken from `known', only edges to and
+ *  from `changed' nodes are looked up. `known' must have been collected for
+ *  the same list of nodes.
+ *  @return Sorted list of routes, or 0 if the graph contains cycles (feedback loops).
+ */
+bool
+ARDOUR::topological_sort (GraphNodeList& nodes, GraphEdges& edges, GraphEdges const& known, std::set<GraphVertex> const& changed)
+{
+	edges.add_all_except (known, changed);
+
+	for (auto const& c : changed) {
+
+		for (auto const& j : nodes) {
+
+			bool via_sends_only = false;
+
+			if (c->direct_feeds_according_to_reality (j, &via_sends_only)) {
+				edges.add (c, j, via_sends_only);
+			}
+
+			if (j == c || changed.find (j) != changed.end ()) {
+				/* edges between changed nodes are found from the other side */
+				continue;
+			}
+
+			via_sends_only = false;
+			if (j->direct_feeds_according_to_reality (c, &via_sends_only)) {
+				edges.add (j, c, via_sends_only);
+			}
+		}
+	}
+
+	return sort_by_edges (nodes, edges);
+}
@@ -258,12 +258,14 @@ CLASSKEYS(ARDOUR::CoreSelection);
 CLASSKEYS(ARDOUR::DSP::DspShm);
 CLASSKEYS(ARDOUR::DataType);
 CLASSKEYS(ARDOUR::FluidSynth);
+CLASSKEYS(ARDOUR::GraphWakeupStats);
 CLASSKEYS(ARDOUR::InternalSend);
 CLASSKEYS(ARDOUR::Latent);
 CLASSKEYS(ARDOUR::Location);
 CLASSKEYS(ARDOUR::LuaAPI::Vamp);
 CLASSKEYS(ARDOUR::LuaOSC::Address);
 CLASSKEYS(ARDOUR::LuaProc);
+CLASSKEYS(ARDOUR::LuaProc::GCStats);
 CLASSKEYS(ARDOUR::LuaTableRef);
 CLASSKEYS(ARDOUR::MidiModel::NoteDiffCommand);
 CLASSKEYS(ARDOUR::MonitorProcessor);
@@ -290,6 +292,7 @@ CLASSKEYS(Temporal::timecnt_t)
 CLASSKEYS(Temporal::superclock_t)
 
 CLASSKEYS(PBD::ID);
+CLASSKEYS(PBD::MagazinePool::Stats);
 CLASSKEYS(PBD::Configuration);
 CLASSKEYS(PBD::PropertyChange);
 CLASSKEYS(PBD::StatefulDestructible);
@@ -488,6 +491,14 @@ LuaBindings::common (lua_State* L)
 
 		.beginStdVector <PBD::ID> ("IdVector").endClass ()
 
+		.beginClass <PBD::MagazinePool::Stats> ("MagazinePoolStats")
+		.addData ("total", &PBD::MagazinePool::Stats::total, false)
+		.addData ("used", &PBD::MagazinePool::Stats::used, false)
+		.addData ("high_water", &PBD::MagazinePool::Stats::high_water, false)
+		.addData ("exhausted", &PBD::MagazinePool::Stats::exhausted, false)
+		.addData ("lazy_caches", &PBD::MagazinePool::Stats::lazy_caches, false)
+		.endClass ()
+
 		.beginClass <XMLNode> ("XMLNode")
 		.addFunction ("name", &XMLNode::name)
 		.endClass ()
@@ -1471,6 +1482,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("set_meter_point", &Route::set_meter_point)
 		.addFunction ("signal_latency", &Route::signal_latency)
 		.addFunction ("playback_latency", &Route::playback_latency)
+		.addFunction ("set_pipelined", &Route::set_pipelined)
+		.addFunction ("pipelined", &Route::pipelined)
 		.addFunction ("monitoring_state", &Route::monitoring_state)
 		.addFunction ("monitoring_control", &Route::monitoring_control)
 		.addFunction ("surround_send", &Route::surround_send)
@@ -1801,6 +1814,14 @@ LuaBindings::common (lua_State* L)
 		.addData ("valid", &Plugin::PresetRecord::valid, false)
 		.endClass ()
 
+		.beginClass <LuaProc::GCStats> ("LuaProcGCStats")
+		.addData ("kbytes", &LuaProc::GCStats::kbytes, false)
+		.addData ("time_avg", &LuaProc::GCStats::time_avg, false)
+		.addData ("time_max", &LuaProc::GCStats::time_max, false)
+		.addData ("deferred", &LuaProc::GCStats::deferred, false)
+		.addData ("helper_time", &LuaProc::GCStats::helper_time, false)
+		.endClass ()
+
 		.beginStdVector <Plugin::PresetRecord> ("PresetVector").endClass ()
 		.beginStdList <std::shared_ptr<ARDOUR::PluginInfo> > ("PluginInfoList").endClass ()
 
@@ -1998,6 +2019,7 @@ LuaBindings::common (lua_State* L)
 		.deriveWSPtrClass <LuaProc, Plugin> ("LuaProc")
 		.addFunction ("shmem", &LuaProc::instance_shm)
 		.addFunction ("table", &LuaProc::instance_ref)
+		.addFunction ("gc_stats", &LuaProc::gc_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <PluginInsert, Processor> ("PluginInsert")
@@ -2875,6 +2897,16 @@ LuaBindings::common (lua_State* L)
 		.addData ("max", &LatencyRange::max)
 		.endClass()
 
+		.beginClass <GraphWakeupStats> ("GraphWakeupStats")
+		.addData ("cycles", &GraphWakeupStats::cycles, false)
+		.addData ("spins", &GraphWakeupStats::spins, false)
+		.addData ("sleeps", &GraphWakeupStats::sleeps, false)
+		.endClass()
+
+		.beginClass <SessionEvent> ("SessionEvent")
+		.addStaticFunction ("pool_stats", &SessionEvent::pool_stats)
+		.endClass()
+
 		.beginClass <PortManager> ("PortManager")
 		.addFunction ("port_engine", &PortManager::port_engine)
 		.addFunction ("connected", &PortManager::connected)
@@ -2890,6 +2922,8 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("n_physical_outputs", &PortManager::n_physical_outputs)
 		.addFunction ("n_physical_inputs", &PortManager::n_physical_inputs)
 		.addFunction ("reset_input_meters", &PortManager::reset_input_meters)
+		.addFunction ("subscribe_input_meter", &PortManager::subscribe_input_meter)
+		.addFunction ("unsubscribe_input_meter", &PortManager::unsubscribe_input_meter)
 		.addRefFunction ("get_connections", &PortManager::get_connections)
 		.addRefFunction ("get_ports", (int (PortManager::*)(DataType, PortManager::PortList&))&PortManager::get_ports)
 		.addRefFunction ("get_backend_ports", (int (PortManager::*)(const std::string&, DataType, PortFlags, std::vector<std::string>&))&PortManager::get_ports)
@@ -3015,6 +3049,7 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("get_stripables", (StripableList (Session::*)() const)&Session::get_stripables)
 		.addFunction ("get_routelist", &Session::get_routelist)
 		.addFunction ("plot_process_graph", &Session::plot_process_graph)
+		.addFunction ("graph_wakeup_stats", &Session::graph_wakeup_stats)
 
 		.addFunction ("bundles", &Session::bundles)
 
@@ -3249,6 +3284,7 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("run_mono_no_latency", &ARDOUR::DSP::Convolution::run_mono_no_latency)
 		.addFunction ("restart", &ARDOUR::DSP::Convolution::restart)
 		.addFunction ("ready", &ARDOUR::DSP::Convolution::ready)
+		.addStaticFunction ("scheduler_overruns", &ARDOUR::DSP::Convolution::scheduler_overruns)
 		.addFunction ("latency", &ARDOUR::DSP::Convolution::latency)
 		.addFunction ("n_inputs", &ARDOUR::DSP::Convolution::n_inputs)
 		.addFunction ("n_outputs", &ARDOUR::DSP::Convolution::n_outputs)
@@ -24,9 +24,12 @@
 #include <glibmm/fileutils.h>
 
 #include "pbd/gstdio_compat.h"
+#include "pbd/microseconds.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/semutils.h"
 
 #include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
 #include "ardour/buffer_set.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/luabindings.h"
@@ -34,6 +37,7 @@
 #include "ardour/luascripting.h"
 #include "ardour/midi_buffer.h"
 #include "ardour/plugin.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/session.h"
 
 #include "LuaBridge/LuaBridge.h"
@@ -43,11 +47,116 @@
 using namespace ARDOUR;
 using namespace PBD;
 
+/* size of the realtime memory pool of each instance */
+static const size_t lua_dsp_mempool_size = 3145728;
+
+namespace ARDOUR {
+
+/** Background thread to continue garbage collection of Lua DSP
+ * scripts that exceeded their per cycle budget.
+ * The thread exists while there are LuaProc instances.
+ */
+class LuaProcGC
+{
+public:
+	static void add (LuaProc*);
+	static void remove (LuaProc*);
+
+	/* realtime safe */
+	static void signal () { _instance->_sem.signal (); }
+
+private:
+	LuaProcGC ();
+	~LuaProcGC ();
+
+	void run ();
+
+	Glib::Threads::Mutex _lock; /* protects _procs */
+	std::set<LuaProc*>   _procs;
+	PBD::Semaphore       _sem;
+	PBD::Thread*         _thread;
+	std::atomic<bool>    _exit;
+
+	static Glib::Threads::Mutex _instance_lock;
+	static LuaProcGC*           _instance;
+};
+
+}
+
+Glib::Threads::Mutex LuaProcGC::_instance_lock;
+LuaProcGC*           LuaProcGC::_instance = 0;
+
+LuaProcGC::LuaProcGC ()
+	: _sem ("LuaProcGC", 0)
+	, _exit (false)
+{
+	_thread = PBD::Thread::create (boost::bind (&LuaProcGC::run, this), "LuaProcGC");
+}
+
+LuaProcGC::~LuaProcGC ()
+{
+	_exit = true;
+	_sem.signal ();
+	_thread->join ();
+	delete _thread;
+}
+
+void
+LuaProcGC::add (LuaProc* p)
+{
+	Glib::Threads::Mutex::Lock lx (_instance_lock);
+	if (!_instance) {
+		_instance = new LuaProcGC;
+	}
+	Glib::Threads::Mutex::Lock lm (_instance->_lock);
+	_instance->_procs.insert (p);
+}
+
+void
+LuaProcGC::remove (LuaProc* p)
+{
+	Glib::Threads::Mutex::Lock lx (_instance_lock);
+	assert (_instance);
+	{
+		/* waits for gc_idle_work () to complete */
+		Glib::Threads::Mutex::Lock lm (_instance->_lock);
+		_instance->_procs.erase (p);
+		if (!_instance->_procs.empty ()) {
+			return;
+		}
+	}
+	delete _instance;
+	_instance = 0;
+}
+
+void
+LuaProcGC::run ()
+{
+	/* The process thread may have to wait for a GC step to complete,
+	 * run with realtime priority (below the process threads), so that
+	 * regular threads cannot preempt the GC while it holds the lock.
+	 */
+	pbd_set_thread_priority (pthread_self (), PBD_SCHED_FIFO, AudioEngine::instance ()->client_real_time_priority () - 2);
+
+	while (true) {
+		_sem.wait ();
+		if (_exit) {
+			return;
+		}
+		Glib::Threads::Mutex::Lock lm (_lock);
+		for (std::set<LuaProc*>::const_iterator i = _procs.begin (); i != _procs.end (); ++i) {
+			(*i)->gc_idle_work ();
+		}
+	}
+}
+
+/* ****************************************************************************/
+
 LuaProc::LuaProc (AudioEngine& engine,
                   Session& session,
                   const std::string &script)
 	: Plugin (engine, session)
-	, _mempool ("LuaProc", 3145728)
+	, _mempool ("LuaProc", lua_dsp_mempool_size)
 #ifdef USE_TLSF
 	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
 #elif defined USE_MALLOC
@@ -79,11 +188,13 @@ LuaProc::LuaProc (AudioEngine& engine,
 	if (!_script.empty () && load_script ()) {
 		throw failed_constructor ();
 	}
+
+	LuaProcGC::add (this);
 }
 
 LuaProc::LuaProc (const LuaProc &other)
 	: Plugin (other)
-	, _mempool ("LuaProc", 3145728)
+	, _mempool ("LuaProc", lua_dsp_mempool_size)
 #ifdef USE_TLSF
 	, lua (lua_newstate (&PBD::TLSF::lalloc, &_mempool))
 #elif defined USE_MALLOC
@@ -115,6 +226,8 @@ LuaProc::LuaProc (const LuaProc &other)
 		_control_data[i] = other._shadow_data[i];
 		_shadow_data[i]  = other._shadow_data[i];
 	}
+
+	LuaProcGC::add (this);
 }
 
 LuaProc::~LuaProc () {
@@ -132,6 +245,8 @@ LuaProc::~LuaProc () {
 				_stats_max[1] * (float)_stats_cnt / _stats_avg[1]);
 	}
 #endif
+	LuaProcGC::remove (this);
+
 	lua.collect_garbage ();
 	delete (_lua_dsp);
 	delete (_lua_latency);
@@ -147,6 +262,18 @@ LuaProc::init ()
 	_stats_cnt = -25;
 #endif
 
+	_gc_rt_waiting  = false;
+	_gc_pending     = false;
+	_gc_budgeted    = false;
+	_gc_emergency   = false;
+	_gc_baseline    = 0;
+	_gc_kbytes      = 0;
+	_gc_time_sum    = 0;
+	_gc_time_max    = 0;
+	_gc_cycles      = 0;
+	_gc_deferred    = 0;
+	_gc_helper_time = 0;
+
 	lua.Print.connect (sigc::mem_fun (*this, &LuaProc::lua_print));
 	// register session object
 	lua_State* L = lua.getState ();
@@ -185,6 +312,7 @@ LuaProc::init ()
 void
 LuaProc::drop_references ()
 {
+	PBD::SpinLock sl (_gc_lock);
 	lua.collect_garbage ();
 	Plugin::drop_references ();
 }
@@ -238,6 +366,8 @@ LuaProc::load_script ()
 		return true;
 	}
 
+	PBD::SpinLock sl (_gc_lock);
+
 	lua_State* L = lua.getState ();
 	lua.do_command (_script);
 
@@ -479,6 +609,7 @@ LuaProc::match_variable_io (ChanCount& in, ChanCount& aux_in, ChanCount& out)
 	in += aux_in;
 
 	/* caller must hold process lock (no concurrent calls to interpreter */
+	PBD::SpinLock sl (_gc_lock);
 	_output_configs.clear ();
 
 	lua_State* L = lua.getState ();
@@ -663,6 +794,8 @@ LuaProc::reconfigure_io (ChanCount in, ChanCount aux_in, ChanCount out)
 	in += aux_in;
 	assert (in == _selected_in && out ==_selected_out);
 
+	PBD::SpinLock sl (_gc_lock);
+
 	in.set (DataType::MIDI, _has_midi_input ? 1 : 0);
 	out.set (DataType::MIDI, _has_midi_output ? 1 : 0);
 
@@ -752,6 +885,17 @@ LuaProc::connect_and_run (BufferSet& bufs,
 	int64_t t0 = g_get_monotonic_time ();
 #endif
 
+	/* The LuaProcGC thread only holds the lock for a single GC step,
+	 * and backs off when we're waiting. If it holds the lock, it
+	 * is busy collecting, and the GC step of this cycle is skipped.
+	 */
+	const bool gc_idle = _gc_lock.try_lock ();
+	if (!gc_idle) {
+		_gc_rt_waiting = true;
+		_gc_lock.lock ();
+		_gc_rt_waiting = false;
+	}
+
 	try {
 		lua_State* L = lua.getState ();
 
@@ -912,15 +1056,22 @@ LuaProc::connect_and_run (BufferSet& bufs,
 		std::cerr << "LuaException: " << e.what () << "\n";
 #endif
 		PBD::warning << "LuaException: " << e.what () << "\n";
+		_gc_lock.unlock ();
 		return -1;
 	} catch (...) {
+		_gc_lock.unlock ();
 		return -1;
 	}
 #ifdef WITH_LUAPROC_STATS
 	int64_t t1 = g_get_monotonic_time ();
 #endif
 
-	lua.collect_garbage_step ();
+	if (gc_idle) {
+		gc_step ();
+	} else if (_gc_pending) {
+		LuaProcGC::signal ();
+	}
+	_gc_lock.unlock ();
 #ifdef WITH_LUAPROC_STATS
 	if (++_stats_cnt > 0) {
 		int64_t t2 = g_get_monotonic_time ();
@@ -936,6 +1087,118 @@ LuaProc::connect_and_run (BufferSet& bufs,
 }
 
 
+void
+LuaProc::gc_step ()
+{
+	/* called in process context, with _gc_lock held */
+	lua_State* L = lua.getState ();
+	const int64_t budget = Config->get_lua_dsp_gc_budget ();
+	const int64_t t0     = PBD::get_microseconds ();
+
+	if (budget == 0) {
+		if (_gc_budgeted) {
+			lua_gc (L, LUA_GCRESTART, 0);
+			_gc_budgeted = false;
+			_gc_pending  = false;
+		}
+		lua.collect_garbage_step ();
+	} else {
+		if (!_gc_budgeted) {
+			/* do not collect garbage while allocating memory, only here */
+			lua_gc (L, LUA_GCSTOP, 0);
+			_gc_budgeted  = true;
+			_gc_emergency = false;
+			_gc_baseline  = lua_gc (L, LUA_GCCOUNT, 0);
+		}
+
+		/* The collector is stopped, so the script's memory is only
+		 * reclaimed here and by the LuaProcGC thread. If the pool runs
+		 * low, restart it until the current cycle completes: the
+		 * collector then does a bounded incremental step with every
+		 * allocation of the script.
+		 */
+		if (!_gc_emergency && lua_gc (L, LUA_GCCOUNT, 0) > (int) (lua_dsp_mempool_size / 1024) * 3 / 4) {
+			lua_gc (L, LUA_GCRESTART, 0);
+			_gc_emergency = true;
+			_gc_pending   = true;
+		}
+
+		if (_gc_pending || lua_gc (L, LUA_GCCOUNT, 0) > _gc_baseline) {
+			/* start a new cycle when the script allocated memory since the last one */
+			bool done;
+			do {
+				done = lua_gc (L, LUA_GCSTEP, 0);
+			} while (!done && PBD::get_microseconds () - t0 < budget);
+
+			if (done) {
+				_gc_pending  = false;
+				_gc_baseline = lua_gc (L, LUA_GCCOUNT, 0);
+				if (_gc_emergency) {
+					lua_gc (L, LUA_GCSTOP, 0);
+					_gc_emergency = false;
+				}
+			} else {
+				/* continue in the background */
+				_gc_pending = true;
+				_gc_deferred.fetch_add (1);
+				LuaProcGC::signal ();
+			}
+		}
+	}
+
+	const int64_t elapsed = PBD::get_microseconds () - t0;
+
+	_gc_kbytes = lua_gc (L, LUA_GCCOUNT, 0);
+	_gc_time_sum.fetch_add (elapsed);
+	_gc_cycles.fetch_add (1);
+	if (elapsed > _gc_time_max.load ()) {
+		_gc_time_max = elapsed;
+	}
+}
+
+void
+LuaProc::gc_idle_work ()
+{
+	if (!_gc_pending) {
+		return;
+	}
+
+	lua_State* L = lua.getState ();
+	const int64_t t0 = PBD::get_microseconds ();
+
+	while (_gc_pending) {
+		/* yield to the process thread */
+		if (_gc_rt_waiting || !_gc_lock.try_lock ()) {
+			break;
+		}
+		if (_gc_pending && lua_gc (L, LUA_GCSTEP, 0)) {
+			_gc_pending  = false;
+			_gc_baseline = lua_gc (L, LUA_GCCOUNT, 0);
+			_gc_kbytes   = _gc_baseline;
+			if (_gc_emergency) {
+				lua_gc (L, LUA_GCSTOP, 0);
+				_gc_emergency = false;
+			}
+		}
+		_gc_lock.unlock ();
+	}
+
+	_gc_helper_time.fetch_add (PBD::get_microseconds () - t0);
+}
+
+LuaProc::GCStats
+LuaProc::gc_stats () const
+{
+	GCStats s;
+	int64_t const n = _gc_cycles.load ();
+	s.kbytes      = _gc_kbytes.load ();
+	s.time_avg    = n > 0 ? _gc_time_sum.load () / n : 0;
+	s.time_max    = _gc_time_max.load ();
+	s.deferred    = _gc_deferred.load ();
+	s.helper_time = _gc_helper_time.load ();
+	return s;
+}
+
 void
 LuaProc::add_state (XMLNode* root) const
 {
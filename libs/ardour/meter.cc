@@ -41,6 +41,9 @@ using namespace std;
 
 using namespace ARDOUR;
 
+/* meter-types that need per channel DSP in addition to the digital peak meter */
+static const int dsp_meter_types = MeterKrms | MeterK20 | MeterK14 | MeterK12 | MeterIEC1DIN | MeterIEC1NOR | MeterIEC2BBC | MeterIEC2EBU | MeterVU;
+
 PeakMeter::PeakMeter (Session& s, const std::string& name)
 	: Processor (s, string_compose ("meter-%1", name), Temporal::TimeDomainProvider (Temporal::AudioTime))
 {
@@ -52,9 +55,12 @@ PeakMeter::PeakMeter (Session& s, const std::string& name)
 	_pending_active = true;
 	_meter_type     = MeterPeak;
 	_bufcnt         = 0;
+	_process_types  = 0;
+	_observe_cnt    = 0;
 
 	_reset_dpm.store (1);
 	_reset_max.store (1);
+	_observed_types.store (0);
 }
 
 PeakMeter::~PeakMeter ()
@@ -112,6 +118,22 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 
 	_bufcnt += nframes;
 
+	/* Only run DSP meters that were read (GUI, control surfaces) during the
+	 * last second. Types that are requested start processing immediately.
+	 */
+	int mtypes = _process_types | _observed_types.load (std::memory_order_relaxed);
+
+	_observe_cnt += nframes;
+	if (_observe_cnt > _session.nominal_sample_rate ()) {
+		_observe_cnt = 0;
+		mtypes = _observed_types.exchange (0);
+	}
+	if (mtypes & ~_process_types) {
+		/* do not continue from stale state */
+		reset_dsp_meters (mtypes & ~_process_types);
+	}
+	_process_types = mtypes;
+
 	/* Meter MIDI */
 	for (uint32_t i = 0; i < n_midi; ++i, ++n) {
 		float val = 0.0f;
@@ -175,16 +197,16 @@ PeakMeter::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos_t /*end
 			}
 		}
 
-		if (_meter_type & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
+		if (mtypes & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
 			_kmeter[i]->process (bufs.get_audio (i).data (), nframes);
 		}
-		if (_meter_type & (MeterIEC1DIN | MeterIEC1NOR)) {
+		if (mtypes & (MeterIEC1DIN | MeterIEC1NOR)) {
 			_iec1meter[i]->process (bufs.get_audio (i).data (), nframes);
 		}
-		if (_meter_type & (MeterIEC2BBC | MeterIEC2EBU)) {
+		if (mtypes & (MeterIEC2BBC | MeterIEC2EBU)) {
 			_iec2meter[i]->process (bufs.get_audio (i).data (), nframes);
 		}
-		if (_meter_type & MeterVU) {
+		if (mtypes & MeterVU) {
 			_vumeter[i]->process (bufs.get_audio (i).data (), nframes);
 		}
 	}
@@ -363,6 +385,10 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 float
 PeakMeter::meter_level (uint32_t n, MeterType type)
 {
+	if (type & dsp_meter_types) {
+		_observed_types.fetch_or (type, std::memory_order_relaxed);
+	}
+
 	if (_reset_max.load ()) {
 		if (n < current_meters.n_midi () && type != MeterMaxPeak) {
 			return 0;
@@ -453,32 +479,36 @@ PeakMeter::set_meter_type (MeterType t)
 
 	_meter_type = t;
 
+	reset_dsp_meters (t);
+
+	MeterTypeChanged (t); /* EMIT SIGNAL */
+}
+
+void
+PeakMeter::reset_dsp_meters (int t)
+{
+	const size_t n_audio = std::min<size_t> (current_meters.n_audio (), _kmeter.size ());
+
 	if (t & (MeterKrms | MeterK20 | MeterK14 | MeterK12)) {
-		const size_t n_audio = current_meters.n_audio ();
 		for (size_t n = 0; n < n_audio; ++n) {
 			_kmeter[n]->reset ();
 		}
 	}
 	if (t & (MeterIEC1DIN | MeterIEC1NOR)) {
-		const size_t n_audio = current_meters.n_audio ();
 		for (size_t n = 0; n < n_audio; ++n) {
 			_iec1meter[n]->reset ();
 		}
 	}
 	if (t & (MeterIEC2BBC | MeterIEC2EBU)) {
-		const size_t n_audio = current_meters.n_audio ();
 		for (size_t n = 0; n < n_audio; ++n) {
 			_iec2meter[n]->reset ();
 		}
 	}
 	if (t & MeterVU) {
-		const size_t n_audio = current_meters.n_audio ();
 		for (size_t n = 0; n < n_audio; ++n) {
 			_vumeter[n]->reset ();
 		}
 	}
-
-	MeterTypeChanged (t); /* EMIT SIGNAL */
 }
 
 XMLNode&
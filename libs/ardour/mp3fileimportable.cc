@@ -19,6 +19,7 @@
 
 #define MINIMP3_IMPLEMENTATION
 
+#include <algorithm>
 #include <fcntl.h>
 
 #ifdef PLATFORM_WINDOWS
@@ -42,6 +43,7 @@ Mp3FileImportableSource::Mp3FileImportableSource (const string& path)
 	, _map_addr (0)
 	, _map_length (0)
 	, _buffer (0)
+	, _frame_start (0)
 	, _remain (0)
 	, _read_position (0)
 	, _pcm_off (0)
@@ -98,8 +100,11 @@ Mp3FileImportableSource::Mp3FileImportableSource (const string& path)
 	_length = _n_frames * _map_length / _info.frame_bytes;
 
 #if 1 /* detect accurate length by parsing frame headers */
+	_seek_index.reserve (_length / std::max (1, _n_frames) + 1);
+	_seek_index.push_back (SeekPoint (0, _frame_start - _map_addr));
 	_length = _n_frames;
 	while (decode_mp3 (true)) {
+		_seek_index.push_back (SeekPoint (_length, _frame_start - _map_addr));
 		_length += _n_frames;
 	}
 	_read_position = _length;
@@ -131,12 +136,21 @@ Mp3FileImportableSource::decode_mp3 (bool parse_only)
 {
 	_pcm_off = 0;
 	do {
+		_frame_start = _buffer;
+		_info.frame_offset = -1;
 		_n_frames = mp3dec_decode_frame (&_mp3d, _buffer, _remain, parse_only ? NULL : _pcm, &_info);
 		_buffer += _info.frame_bytes;
 		_remain -= _info.frame_bytes;
 		if (_n_frames) {
 			break;
 		}
+		if (_info.frame_offset >= 0 && _info.frame_bytes > 0) {
+			/* a frame was found, but could not be decoded, e.g. the
+			 * bit-reservoir is still empty after seeking. Its samples
+			 * are skipped, keep the read-position in sync.
+			 */
+			_read_position += hdr_frame_samples (_frame_start + _info.frame_offset);
+		}
 	} while (_info.frame_bytes);
 	return _n_frames;
 }
@@ -148,8 +162,28 @@ Mp3FileImportableSource::seek (samplepos_t pos)
 		return;
 	}
 
-	/* rewind, then decode to pos */
-	if (pos < _read_position) {
+	if (!_seek_index.empty ()) {
+		/* find the frame that contains pos */
+		std::vector<SeekPoint>::const_iterator i = std::upper_bound (_seek_index.begin (), _seek_index.end (), pos,
+				[] (samplepos_t p, SeekPoint const& sp) { return p < sp.sample; });
+		size_t n = std::distance (_seek_index.cbegin (), i);
+		n = n > 0 ? n - 1 : 0;
+		/* start decoding two frames earlier, to fill the bit-reservoir
+		 * and MDCT overlap. Frames that cannot be decoded until the
+		 * reservoir is filled are skipped; if that does not leave two
+		 * decoded frames before the target, start further back.
+		 */
+		const samplepos_t preroll_start = _seek_index[n > 2 ? n - 2 : 0].sample;
+		if (pos < _read_position || preroll_start > _read_position) {
+			for (size_t preroll = 2;; preroll *= 2) {
+				seek_to_frame (n > preroll ? n - preroll : 0);
+				if (_read_position <= preroll_start || n <= preroll) {
+					break;
+				}
+			}
+		}
+	} else if (pos < _read_position) {
+		/* rewind, then decode to pos */
 		_buffer        = _map_addr;
 		_remain        = _map_length;
 		_read_position = 0;
@@ -159,25 +193,42 @@ Mp3FileImportableSource::seek (samplepos_t pos)
 	}
 
 	while (_read_position + _n_frames <= pos) {
-		/* skip ahead, until the frame before the target,
-		 * then start decoding. This provides sufficient
+		/* without seek-index, skip ahead until two frames before
+		 * the target, then start decoding. This provides sufficient
 		 * context to prevent audible hiccups, while still
-		 * providing fast and accurate seeking.
+		 * providing fast seeking. Parsed frames do not fill the
+		 * bit-reservoir, so with a seek-index all frames after
+		 * the seek-point are decoded.
 		 */
-		if (!decode_mp3 (_read_position + 3 * _n_frames <= pos)) {
+		int frame_len = _n_frames + _pcm_off / std::max (1, _info.channels);
+		_read_position += _n_frames;
+		_n_frames       = 0;
+		if (!decode_mp3 (_seek_index.empty () && _read_position + 3 * frame_len <= pos)) {
 			break;
 		}
-		_read_position += _n_frames;
 	}
 
 	if (_n_frames > 0) {
-		_pcm_off = _info.channels * (pos - _read_position);
+		_pcm_off += _info.channels * (pos - _read_position);
 		_n_frames -= pos - _read_position;
 		_read_position = pos;
 	}
 	assert (_pcm_off < MINIMP3_MAX_SAMPLES_PER_FRAME);
 }
 
+void
+Mp3FileImportableSource::seek_to_frame (size_t n)
+{
+	assert (n < _seek_index.size ());
+	size_t off     = _seek_index[n].offset;
+	_buffer        = _map_addr + off;
+	_remain        = _map_length - off;
+	_read_position = _seek_index[n].sample;
+	_pcm_off       = 0;
+	mp3dec_init (&_mp3d);
+	decode_mp3 ();
+}
+
 samplecnt_t
 Mp3FileImportableSource::read (Sample* dst, samplecnt_t nframes)
 {
@@ -0,0 +1,232 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
+#include "ardour/buffer_set.h"
+#include "ardour/midi_buffer.h"
+#include "ardour/pipeline_delay.h"
+
+using namespace ARDOUR;
+
+PipelineDelay::PipelineDelay ()
+	: _delay (0)
+	, _size (0)
+	, _rpos (0)
+	, _fill (0)
+{
+	_count.reset ();
+}
+
+PipelineDelay::~PipelineDelay ()
+{
+	clear ();
+}
+
+void
+PipelineDelay::clear ()
+{
+	for (std::vector<AudioBuffer*>::iterator i = _audio.begin (); i != _audio.end (); ++i) {
+		delete *i;
+	}
+	for (std::vector<MidiBuffer*>::iterator i = _midi.begin (); i != _midi.end (); ++i) {
+		delete *i;
+	}
+	_audio.clear ();
+	_midi.clear ();
+	_count.reset ();
+}
+
+void
+PipelineDelay::configure (ChanCount const& count, samplecnt_t delay)
+{
+	if (count != _count || delay != _delay) {
+		clear ();
+		/* room for one additional cycle, in case writes arrive before reads */
+		_delay = delay;
+		_size  = 2 * delay;
+		for (uint32_t i = 0; i < count.n_audio (); ++i) {
+			_audio.push_back (new AudioBuffer (_size));
+		}
+		for (uint32_t i = 0; i < count.n_midi (); ++i) {
+			_midi.push_back (new MidiBuffer (2 * AudioEngine::instance ()->raw_buffer_size (DataType::MIDI)));
+		}
+		_count = count;
+		flush ();
+	}
+}
+
+void
+PipelineDelay::flush ()
+{
+	for (std::vector<AudioBuffer*>::iterator i = _audio.begin (); i != _audio.end (); ++i) {
+		(*i)->silence (_size);
+	}
+	for (std::vector<MidiBuffer*>::iterator i = _midi.begin (); i != _midi.end (); ++i) {
+		(*i)->clear ();
+	}
+	_rpos = 0;
+	_fill = _delay;
+}
+
+void
+PipelineDelay::skip (samplecnt_t n)
+{
+	/* drop data that arrived without a corresponding read */
+	_rpos = (_rpos + n) % _size;
+	_fill -= n;
+
+	for (std::vector<MidiBuffer*>::iterator i = _midi.begin (); i != _midi.end (); ++i) {
+		for (MidiBuffer::iterator m = (*i)->begin (); m != (*i)->end ();) {
+			MidiBuffer::TimeType *t = m.timeptr ();
+			if (*t < n) {
+				m = (*i)->erase (m);
+			} else {
+				*t -= n;
+				++m;
+			}
+		}
+	}
+}
+
+void
+PipelineDelay::pad (samplecnt_t n)
+{
+	/* reads without a corresponding write, prepend silence */
+	_rpos = (_rpos + _size - n) % _size;
+	_fill += n;
+
+	for (std::vector<AudioBuffer*>::iterator i = _audio.begin (); i != _audio.end (); ++i) {
+		if (_rpos + n > _size) {
+			(*i)->silence (_size - _rpos, _rpos);
+			(*i)->silence (_rpos + n - _size, 0);
+		} else {
+			(*i)->silence (n, _rpos);
+		}
+	}
+
+	for (std::vector<MidiBuffer*>::iterator i = _midi.begin (); i != _midi.end (); ++i) {
+		for (MidiBuffer::iterator m = (*i)->begin (); m != (*i)->end (); ++m) {
+			*m.timeptr () += n;
+		}
+	}
+}
+
+void
+PipelineDelay::write (BufferSet const& bufs, pframes_t n_samples)
+{
+	samplecnt_t n = std::min<samplecnt_t> (n_samples, _size - _fill);
+	if (n <= 0) {
+		return;
+	}
+
+	samplecnt_t wpos = (_rpos + _fill) % _size;
+
+	for (uint32_t c = 0; c < _audio.size (); ++c) {
+		AudioBuffer* ab = _audio[c];
+		if (c >= bufs.count ().n_audio ()) {
+			if (wpos + n > _size) {
+				ab->silence (_size - wpos, wpos);
+				ab->silence (wpos + n - _size, 0);
+			} else {
+				ab->silence (n, wpos);
+			}
+			continue;
+		}
+		AudioBuffer const& src (bufs.get_audio (c));
+		if (wpos + n > _size) {
+			samplecnt_t w0 = _size - wpos;
+			ab->read_from (src, w0, wpos, 0);
+			ab->read_from (src, n - w0, 0, w0);
+		} else {
+			ab->read_from (src, n, wpos, 0);
+		}
+	}
+
+	for (uint32_t c = 0; c < _midi.size () && c < bufs.count ().n_midi (); ++c) {
+		MidiBuffer const& src (bufs.get_midi (c));
+		for (MidiBuffer::const_iterator m = src.begin (); m != src.end (); ++m) {
+			Evoral::Event<MidiBuffer::TimeType> ev (*m, false);
+			if (ev.time () >= n) {
+				break;
+			}
+			ev.set_time (ev.time () + _fill);
+			_midi[c]->push_back (ev);
+		}
+	}
+
+	_fill += n;
+}
+
+void
+PipelineDelay::read (BufferSet& bufs, pframes_t n_samples)
+{
+	if (_size == 0) {
+		bufs.silence (n_samples, 0);
+		return;
+	}
+
+	assert (n_samples <= _delay);
+
+	/* keep the delay constant */
+	if (_fill > _delay) {
+		skip (_fill - _delay);
+	} else if (_fill < _delay) {
+		pad (_delay - _fill);
+	}
+
+	samplecnt_t n = n_samples;
+
+	for (uint32_t c = 0; c < bufs.count ().n_audio (); ++c) {
+		AudioBuffer& dst (bufs.get_audio (c));
+		if (c >= _audio.size ()) {
+			dst.silence (n);
+			continue;
+		}
+		if (_rpos + n > _size) {
+			samplecnt_t r0 = _size - _rpos;
+			dst.read_from (*_audio[c], r0, 0, _rpos);
+			dst.read_from (*_audio[c], n - r0, r0, 0);
+		} else {
+			dst.read_from (*_audio[c], n, 0, _rpos);
+		}
+	}
+
+	for (uint32_t c = 0; c < bufs.count ().n_midi (); ++c) {
+		MidiBuffer& dst (bufs.get_midi (c));
+		dst.clear ();
+		if (c >= _midi.size ()) {
+			continue;
+		}
+		MidiBuffer* mb = _midi[c];
+		for (MidiBuffer::iterator m = mb->begin (); m != mb->end ();) {
+			const Evoral::Event<MidiBuffer::TimeType> ev (*m, false);
+			if (ev.time () >= n) {
+				break;
+			}
+			dst.push_back (ev);
+			m = mb->erase (m);
+		}
+		for (MidiBuffer::iterator m = mb->begin (); m != mb->end (); ++m) {
+			*m.timeptr () -= n;
+		}
+	}
+
+	_rpos = (_rpos + n) % _size;
+	_fill -= n;
+}
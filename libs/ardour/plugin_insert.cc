@@ -44,6 +44,7 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rt_tasklist.h"
 
 #ifdef WINDOWS_VST_SUPPORT
 #include "ardour/windows_vst_plugin.h"
@@ -91,9 +92,11 @@ PluginInsert::PluginInsert (Session& s, Temporal::TimeDomainProvider const & tdp
 	, _latency_changed (false)
 	, _bypass_port (UINT32_MAX)
 	, _inverted_bypass_enable (false)
+	, _parallel_instances (false)
 {
 	_stat_reset.store (0);
 	_flush.store (0);
+	_instance_failed.store (false);
 
 	/* the first is the master */
 	if (plug) {
@@ -1137,6 +1140,21 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 				}
 			}
 		}
+	} else if (_parallel_instances && Config->get_parallel_plugin_instances () && _instance_tasks && _instance_tasks->tasks ().size () == get_count ()) {
+		/* in-place processing, instances use disjoint buffers */
+		_instance_cycle.bufs    = &bufs;
+		_instance_cycle.start   = start;
+		_instance_cycle.end     = end;
+		_instance_cycle.speed   = speed;
+		_instance_cycle.nframes = nframes;
+		_instance_cycle.offset  = offset;
+
+		_instance_tasks->process_nested ();
+
+		if (_instance_failed.exchange (false)) {
+			deactivate ();
+		}
+		inplace_silence_unconnected (bufs, _out_map, nframes, offset);
 	} else {
 		/* in-place processing */
 		uint32_t pc = 0;
@@ -1182,6 +1200,15 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 	}
 }
 
+void
+PluginInsert::run_instance (uint32_t pc)
+{
+	InstanceCycle const& c (_instance_cycle);
+	if (_plugins[pc]->connect_and_run (*c.bufs, c.start, c.end, c.speed, _in_map.p (pc), _out_map.p (pc), c.nframes, c.offset)) {
+		_instance_failed.store (true);
+	}
+}
+
 void
 PluginInsert::bypass (BufferSet& bufs, pframes_t nframes)
 {
@@ -1755,9 +1782,38 @@ PluginInsert::mapping_changed ()
 {
 	PluginMapChanged (); /* EMIT SIGNAL */
 	_no_inplace = check_inplace ();
+	_parallel_instances = check_parallel_instances ();
 	_session.set_dirty();
 }
 
+bool
+PluginInsert::check_parallel_instances () const
+{
+	if (_no_inplace || get_count () < 2) {
+		return false;
+	}
+
+	/* every buffer may only be used by a single plugin instance,
+	 * [data-type] buffer-index => instance */
+	ChanMapping used;
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		for (int io = 0; io < 2; ++io) {
+			ChanMapping::Mappings const& m ((io == 0 ? _in_map : _out_map).p (pc).mappings ());
+			for (ChanMapping::Mappings::const_iterator t = m.begin (); t != m.end (); ++t) {
+				for (ChanMapping::TypeMapping::const_iterator c = (*t).second.begin (); c != (*t).second.end () ; ++c) {
+					bool valid;
+					uint32_t user = used.get (t->first, c->second, &valid);
+					if (valid && user != pc) {
+						return false;
+					}
+					used.set (t->first, c->second, pc);
+				}
+			}
+		}
+	}
+	return true;
+}
+
 bool
 PluginInsert::check_inplace ()
 {
@@ -2264,6 +2320,14 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 	}
 
 	_no_inplace = check_inplace ();
+	_parallel_instances = check_parallel_instances ();
+
+	if (get_count () > 1 && (!_instance_tasks || _instance_tasks->tasks ().size () != get_count ())) {
+		_instance_tasks.reset (new RTTaskList (_session.process_graph ()));
+		for (uint32_t pc = 0; pc < get_count (); ++pc) {
+			_instance_tasks->push_back (boost::bind (&PluginInsert::run_instance, this, pc));
+		}
+	}
 
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
@@ -91,6 +91,10 @@
 #include "ardour/vst2_scan.h"
 #endif
 
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+#include "pbd/cpus.h"
+#endif
+
 #ifdef WINDOWS_VST_SUPPORT
 #include "ardour/windows_vst_plugin.h"
 #endif
@@ -180,7 +184,8 @@ PluginManager::instance()
 }
 
 PluginManager::PluginManager ()
-	: _windows_vst_plugin_info(0)
+	: _scan_index (Glib::build_filename (ARDOUR::user_cache_directory (), "plugin_scan_index"))
+	, _windows_vst_plugin_info(0)
 	, _lxvst_plugin_info(0)
 	, _mac_vst_plugin_info(0)
 	, _vst3_plugin_info(0)
@@ -196,6 +201,8 @@ PluginManager::PluginManager ()
 {
 	char* s;
 
+	_scan_index.load ();
+
 #if defined WINDOWS_VST_SUPPORT || defined LXVST_SUPPORT || defined MACVST_SUPPORT || defined VST3_SUPPORT
 	// source-tree (ardev, etc)
 	PBD::Searchpath vstsp(Glib::build_filename(ARDOUR::ardour_dll_directory(), "fst"));
@@ -649,6 +656,7 @@ PluginManager::detect_ambiguities ()
 	detect_type_ambiguities (all_plugs);
 
 	save_scanlog ();
+	_scan_index.save ();
 	PluginListChanged (); /* EMIT SIGNAL */
 }
 
@@ -1413,6 +1421,144 @@ PluginManager::au_refresh (bool cache_only)
 
 #endif
 
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+
+static void scanner_log (std::string msg, std::stringstream* ss)
+{
+	*ss << msg;
+}
+
+/** Run out-of-process scanners, up to plugin-scan-jobs concurrently.
+ * Each scanner has its own timeout.
+ *
+ * @param title if not empty, announce each job with a PluginScanMessage
+ */
+void
+PluginManager::run_scanner_apps (std::string const& scanner_bin, std::string const& title, std::vector<ScannerJob>& jobs)
+{
+	struct Scan {
+		Scan (ScannerJob& j) : job (j), exec (0), timeout (0), notime (true) {}
+		~Scan () { c.disconnect (); delete exec; }
+
+		ScannerJob&           job;
+		ARDOUR::SystemExec*   exec;
+		std::stringstream     log;
+		PBD::ScopedConnection c;
+		int                   timeout; /* deciseconds */
+		bool                  notime;
+	};
+
+	size_t max_running = Config->get_plugin_scan_jobs ();
+	if (max_running == 0) {
+		max_running = std::max<uint32_t> (1, hardware_concurrency ());
+	}
+
+	std::list<Scan*> running;
+	size_t           next = 0;
+
+	while (next < jobs.size () || !running.empty ()) {
+
+		/* launch scanners */
+		while (running.size () < max_running && next < jobs.size () && !cancelled ()) {
+			ScannerJob& job (jobs[next++]);
+
+			if (running.empty ()) {
+				reset_scan_cancel_state (true);
+			}
+
+			if (!title.empty ()) {
+				ARDOUR::PluginScanMessage (string_compose (_("%1 (%2 / %3)"), title, next, jobs.size ()), job.path, true);
+			}
+
+			if (job.start) {
+				job.start ();
+			}
+
+			char **argp= (char**) calloc (5, sizeof (char*));
+			argp[0] = strdup (scanner_bin.c_str ());
+			argp[1] = strdup ("-f");
+			if (Config->get_verbose_plugin_scan()) {
+				argp[2] = strdup ("-v");
+			} else {
+				argp[2] = strdup ("-f");
+			}
+			argp[3] = strdup (job.path.c_str ());
+			argp[4] = 0;
+
+			Scan* scan = new Scan (job);
+			scan->exec = new ARDOUR::SystemExec (scanner_bin, argp);
+			scan->exec->ReadStdout.connect_same_thread (scan->c, boost::bind (&scanner_log, _1, &scan->log));
+
+			if (scan->exec->start (ARDOUR::SystemExec::MergeWithStdin)) {
+				job.psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), scanner_bin, strerror (errno)));
+				delete scan;
+				continue;
+			}
+
+			scan->timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0;
+			scan->notime  = (scan->timeout <= 0);
+			running.push_back (scan);
+		}
+
+		if (running.empty ()) {
+			/* cancelled */
+			break;
+		}
+
+		Glib::usleep (100000);
+
+		for (std::list<Scan*>::iterator i = running.begin (); i != running.end ();) {
+			Scan* scan = *i;
+
+			if (!scan->notime && no_timeout ()) {
+				scan->notime = true;
+				scan->timeout = -1;
+			} else if (scan->notime && !no_timeout() && _enable_scan_timeout) {
+				scan->notime = false;
+				scan->timeout = 1 + Config->get_plugin_scan_timeout ();
+			}
+
+			if (scan->timeout > -864000) {
+				--scan->timeout;
+			}
+
+			if (!scan->exec->is_running ()) {
+				scan->job.psle->msg (PluginScanLogEntry::OK, scan->log.str());
+				scan->job.completed = true;
+			} else if (cancelled () || (!scan->notime && scan->timeout == 0)) {
+				scan->exec->terminate ();
+				scan->job.psle->msg (PluginScanLogEntry::OK, scan->log.str());
+				if (cancelled ()) {
+					scan->job.psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
+				} else {
+					scan->job.psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
+				}
+				if (scan->job.abort) {
+					scan->job.abort ();
+				}
+			} else {
+				++i;
+				continue;
+			}
+
+			delete scan;
+			i = running.erase (i);
+		}
+
+		if (!running.empty ()) {
+			/* report the oldest scan that is still running */
+			ARDOUR::PluginScanTimeout (running.front ()->timeout);
+		}
+
+		if (running.empty () && _cancel_scan_one && !_cancel_scan_all) {
+			/* skipped the current scan(s), continue with the next */
+			reset_scan_cancel_state (true);
+		}
+	}
+}
+
+#endif
+
 #if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT)
 
 static bool vst2_is_blacklisted (string const& module_path)
@@ -1472,69 +1618,95 @@ static void vst2_whitelist (string module_path)
 	Glib::file_set_contents (fn, bl);
 }
 
-static void vst2_scanner_log (std::string msg, std::stringstream* ss)
+bool
+PluginManager::run_vst2_scanner_app (std::string path, PSLEPtr psle)
 {
-	*ss << msg;
+	std::vector<ScannerJob> jobs;
+	jobs.push_back (ScannerJob (path, psle));
+	jobs.back ().abort = [path] () {
+		/* may be partially written */
+		g_unlink (vst2_cache_file (path).c_str ());
+		vst2_whitelist (path);
+	};
+
+	run_scanner_apps (vst2_scanner_bin_path, "", jobs);
+	return jobs.back ().completed;
 }
 
-bool
-PluginManager::run_vst2_scanner_app (std::string path, PSLEPtr psle) const
-{
-	char **argp= (char**) calloc (5, sizeof (char*));
-	argp[0] = strdup (vst2_scanner_bin_path.c_str ());
-	argp[1] = strdup ("-f");
-	if (Config->get_verbose_plugin_scan()) {
-		argp[2] = strdup ("-v");
-	} else {
-		argp[2] = strdup ("-f");
+std::string
+PluginManager::vst2_indexed_cache_file (std::string const& path, ARDOUR::PluginType type, bool* is_new)
+{
+	std::string const cache_file = vst2_cache_file (path);
+
+	switch (_scan_index.status (type, path, cache_file, ARDOUR_VST2_CACHE_FILE_VERSION)) {
+		case PluginScanIndex::Unchanged:
+			*is_new = false;
+			return cache_file;
+		case PluginScanIndex::Modified:
+			/* plugin was modified in place, re-scan */
+			*is_new = false;
+			return "";
+		default:
+			break;
 	}
-	argp[3] = strdup (path.c_str ());
-	argp[4] = 0;
-
-	stringstream scan_log;
-	ARDOUR::SystemExec scanner (vst2_scanner_bin_path, argp);
-	PBD::ScopedConnection c;
-	scanner.ReadStdout.connect_same_thread (c, boost::bind (&vst2_scanner_log, _1, &scan_log));
+	return vst2_valid_cache_file (path, false, is_new);
+}
 
-	if (scanner.start (ARDOUR::SystemExec::MergeWithStdin)) {
-		psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), vst2_scanner_bin_path, strerror (errno)));
-		return false;
+/** Run the scanner app for all plugins that need to be (re)scanned
+ * concurrently. vst2_discover() will then find valid cache-files.
+ *
+ * @param skip is filled with plugins that were not scanned (cancel, timeout)
+ */
+void
+PluginManager::vst2_prescan (std::vector<std::string> const& paths, ARDOUR::PluginType type, std::set<std::string>& skip)
+{
+	if (vst2_scanner_bin_path.empty () || cancelled ()) {
+		return;
 	}
 
-	int timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0; /* deciseconds */
-	bool notime = (timeout <= 0);
+	std::vector<ScannerJob> jobs;
 
-	while (scanner.is_running () && (notime || timeout > 0)) {
-		if (!notime && no_timeout ()) {
-			notime = true;
-			timeout = -1;
-		} else if (notime && !no_timeout() && _enable_scan_timeout) {
-			notime = false;
-			timeout = 1 + Config->get_plugin_scan_timeout ();
-		}
+	for (std::vector<std::string>::const_iterator i = paths.begin (); i != paths.end (); ++i) {
+		std::string const path (*i);
+		bool is_new;
 
-		if (timeout > -864000) {
-			--timeout;
+		if (vst2_is_blacklisted (path) || !vst2_indexed_cache_file (path, type, &is_new).empty ()) {
+			continue;
 		}
-		ARDOUR::PluginScanTimeout (timeout);
-		Glib::usleep (100000);
 
-		if (cancelled () || (!notime && timeout == 0)) {
-			scanner.terminate ();
-			psle->msg (PluginScanLogEntry::OK, scan_log.str());
-			if (cancelled ()) {
-				psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
-			} else {
-				psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
-			}
+		PSLEPtr psle (scan_log_entry (type, path));
+		jobs.push_back (ScannerJob (path, psle));
+
+		jobs.back ().start = [this, path, psle, type] () {
+			psle->reset ();
+			vst2_blacklist (path);
+			_scan_index.remove (type, path);
+		};
+
+		jobs.back ().abort = [path] () {
 			/* may be partially written */
 			g_unlink (vst2_cache_file (path).c_str ());
 			vst2_whitelist (path);
-			return false;
+		};
+	}
+
+	if (jobs.size () < 2) {
+		/* nothing to parallelize */
+		return;
+	}
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("VST2: scanning %1 plugins concurrently\n", jobs.size ()));
+
+	run_scanner_apps (vst2_scanner_bin_path, _("VST2"), jobs);
+
+	for (std::vector<ScannerJob>::const_iterator i = jobs.begin (); i != jobs.end (); ++i) {
+		if (!i->completed) {
+			skip.insert (i->path);
+		} else if (!Glib::file_test (vst2_cache_file (i->path), Glib::FILE_TEST_EXISTS)) {
+			/* the plugin remains blacklisted */
+			i->psle->msg (PluginScanLogEntry::Error, _("Scan Failed."));
 		}
 	}
-	psle->msg (PluginScanLogEntry::OK, scan_log.str());
-	return true;
 }
 
 bool
@@ -1627,7 +1799,7 @@ PluginManager::vst2_discover (string path, ARDOUR::PluginType type, bool cache_o
 	bool run_scan = false;
 	bool is_new   = false;
 
-	string cache_file = vst2_valid_cache_file (path, false, &is_new);
+	string cache_file = vst2_indexed_cache_file (path, type, &is_new);
 
 	if (!cache_only && vst2_scanner_bin_path.empty () && cache_file.empty ()) {
 		/* scan in host context */
@@ -1643,6 +1815,7 @@ PluginManager::vst2_discover (string path, ARDOUR::PluginType type, bool cache_o
 		}
 		psle->msg (PluginScanLogEntry::OK, string_compose (_("Saved VST2 plugin cache to '%1'"), vst2_cache_file (path)));
 		vst2_whitelist (path);
+		_scan_index.update (type, path, vst2_cache_file (path), ARDOUR_VST2_CACHE_FILE_VERSION);
 		return 0;
 	}
 
@@ -1712,6 +1885,7 @@ PluginManager::vst2_discover (string path, ARDOUR::PluginType type, bool cache_o
 
 	vst2_whitelist (path);
 	psle->set_result (PluginScanLogEntry::OK);
+	_scan_index.update (type, path, cache_file, ARDOUR_VST2_CACHE_FILE_VERSION);
 
 	uint32_t discovered = 0;
 	for (XMLNodeConstIterator i = tree.root()->children().begin(); i != tree.root()->children().end(); ++i) {
@@ -1779,12 +1953,17 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> skip;
+	if (!cache_only) {
+		vst2_prescan (plugin_objects, Windows_VST, skip);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
-		vst2_discover (*x, Windows_VST, cache_only || cancelled());
+		vst2_discover (*x, Windows_VST, cache_only || cancelled() || skip.find (*x) != skip.end ());
 	}
 
 	return ret;
@@ -1862,12 +2041,17 @@ PluginManager::mac_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> skip;
+	if (!cache_only) {
+		vst2_prescan (plugin_objects, MacVST, skip);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
-		vst2_discover (*x, MacVST, cache_only || cancelled());
+		vst2_discover (*x, MacVST, cache_only || cancelled() || skip.find (*x) != skip.end ());
 	}
 
 	return 0;
@@ -1922,12 +2106,17 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> skip;
+	if (!cache_only) {
+		vst2_prescan (plugin_objects, LXVST, skip);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
-		vst2_discover (*x, LXVST, cache_only || cancelled());
+		vst2_discover (*x, LXVST, cache_only || cancelled() || skip.find (*x) != skip.end ());
 	}
 
 	return 0;
@@ -2072,13 +2261,18 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 
 	find_paths_matching_filter (plugin_objects, paths, vst3_filter, 0, false, true, true);
 
+	std::set<std::string> skip;
+	if (!cache_only) {
+		vst3_prescan (plugin_objects, skip);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i, ++n) {
 		DEBUG_TRACE (DEBUG::PluginManager, string_compose ("VST3: discover '%1'\n", *i));
 		reset_scan_cancel_state (true);
 		ARDOUR::PluginScanMessage (string_compose (_("VST3 (%1 / %2)"), n, all_modules), *i, !cache_only && !cancelled());
-		vst3_discover (*i, cache_only || cancelled ());
+		vst3_discover (*i, cache_only || cancelled () || skip.find (*i) != skip.end ());
 	}
 
 	return cancelled() ? -1 : 0;
@@ -2142,7 +2336,7 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 	bool run_scan = false;
 	bool is_new   = false;
 
-	string cache_file = vst3_valid_cache_file (module_path, false, &is_new);
+	string cache_file = vst3_indexed_cache_file (module_path, &is_new);
 
 	if (!cache_only && vst3_scanner_bin_path.empty () && cache_file.empty ()) {
 		/* scan in host context */
@@ -2157,6 +2351,7 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 		}
 		psle->msg (PluginScanLogEntry::OK, string_compose (_("Saved VST3 plugin cache to '%1'"), vst3_cache_file (module_path)));
 		vst3_whitelist (module_path);
+		_scan_index.update (VST3, module_path, vst3_cache_file (module_path), ARDOUR_VST3_CACHE_FILE_VERSION);
 		return 0;
 	}
 
@@ -2213,6 +2408,7 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 
 	vst3_whitelist (module_path);
 	psle->set_result (PluginScanLogEntry::OK);
+	_scan_index.update (VST3, module_path, cache_file, ARDOUR_VST3_CACHE_FILE_VERSION);
 
 	for (XMLNodeConstIterator i = tree.root()->children().begin(); i != tree.root()->children().end(); ++i) {
 		try {
@@ -2227,72 +2423,104 @@ PluginManager::vst3_discover (string const& path, bool cache_only)
 	return 0;
 }
 
-static void vst3_scanner_log (std::string msg, std::stringstream* ss)
+bool
+PluginManager::run_vst3_scanner_app (std::string bundle_path, PSLEPtr psle)
 {
-	*ss << msg;
+	std::vector<ScannerJob> jobs;
+	jobs.push_back (ScannerJob (bundle_path, psle));
+	jobs.back ().abort = [bundle_path] () {
+		/* may be partially written */
+		std::string module_path = module_path_vst3 (bundle_path);
+		if (!module_path.empty ()) {
+			g_unlink (vst3_cache_file (module_path).c_str ());
+		}
+		vst3_whitelist (module_path);
+	};
+
+	run_scanner_apps (vst3_scanner_bin_path, "", jobs);
+	return jobs.back ().completed;
 }
 
-bool
-PluginManager::run_vst3_scanner_app (std::string bundle_path, PSLEPtr psle) const
-{
-	char **argp= (char**) calloc (5, sizeof (char*));
-	argp[0] = strdup (vst3_scanner_bin_path.c_str ());
-	argp[1] = strdup ("-f");
-	if (Config->get_verbose_plugin_scan()) {
-		argp[2] = strdup ("-v");
-	} else {
-		argp[2] = strdup ("-f");
+std::string
+PluginManager::vst3_indexed_cache_file (std::string const& module_path, bool* is_new)
+{
+	std::string const cache_file = vst3_cache_file (module_path);
+
+	switch (_scan_index.status (VST3, module_path, cache_file, ARDOUR_VST3_CACHE_FILE_VERSION)) {
+		case PluginScanIndex::Unchanged:
+			*is_new = false;
+			return cache_file;
+		case PluginScanIndex::Modified:
+			/* module was modified in place, re-scan */
+			*is_new = false;
+			return "";
+		default:
+			break;
 	}
-	argp[3] = strdup (bundle_path.c_str ());
-	argp[4] = 0;
-
-	stringstream scan_log;
-	ARDOUR::SystemExec scanner (vst3_scanner_bin_path, argp);
-	PBD::ScopedConnection c;
-	scanner.ReadStdout.connect_same_thread (c, boost::bind (&vst3_scanner_log, _1, &scan_log));
+	return vst3_valid_cache_file (module_path, false, is_new);
+}
 
-	if (scanner.start (ARDOUR::SystemExec::MergeWithStdin)) {
-		psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), vst3_scanner_bin_path, strerror (errno)));
-		return false;
+/** Run the scanner app for all bundles that need to be (re)scanned
+ * concurrently. vst3_discover() will then find valid cache-files.
+ *
+ * @param skip is filled with bundles that were not scanned (cancel, timeout)
+ */
+void
+PluginManager::vst3_prescan (std::vector<std::string> const& bundles, std::set<std::string>& skip)
+{
+	if (vst3_scanner_bin_path.empty () || cancelled ()) {
+		return;
 	}
 
-	int timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0; /* deciseconds */
-	bool notime = (timeout <= 0);
+	std::vector<ScannerJob> jobs;
 
-	while (scanner.is_running () && (notime || timeout > 0)) {
-		if (!notime && no_timeout ()) {
-			notime = true;
-			timeout = -1;
-		} else if (notime && !no_timeout() && _enable_scan_timeout) {
-			notime = false;
-			timeout = 1 + Config->get_plugin_scan_timeout ();
+	for (std::vector<std::string>::const_iterator i = bundles.begin (); i != bundles.end (); ++i) {
+		std::string const module_path = module_path_vst3 (*i);
+		bool is_new;
+
+		if (module_path.empty () || module_path == "-1" || vst3_is_blacklisted (module_path)) {
+			/* vst3_discover() takes care of logging */
+			continue;
 		}
 
-		if (timeout > -864000) {
-			--timeout;
+		if (!vst3_indexed_cache_file (module_path, &is_new).empty ()) {
+			continue;
 		}
-		ARDOUR::PluginScanTimeout (timeout);
-		Glib::usleep (100000);
 
-		if (cancelled () || (!notime && timeout == 0)) {
-			scanner.terminate ();
-			psle->msg (PluginScanLogEntry::OK, scan_log.str());
-			if (cancelled ()) {
-				psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
-			} else {
-				psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
-			}
+		PSLEPtr psle (scan_log_entry (VST3, *i));
+		jobs.push_back (ScannerJob (*i, psle));
+
+		jobs.back ().start = [this, module_path, psle] () {
+			psle->reset ();
+			vst3_blacklist (module_path);
+			_scan_index.remove (VST3, module_path);
+			psle->msg (PluginScanLogEntry::OK, string_compose ("VST3 module-path '%1'", module_path));
+		};
+
+		jobs.back ().abort = [module_path] () {
 			/* may be partially written */
-			std::string module_path = module_path_vst3 (bundle_path);
-			if (!module_path.empty ()) {
-				g_unlink (vst3_cache_file (module_path).c_str ());
-			}
+			g_unlink (vst3_cache_file (module_path).c_str ());
 			vst3_whitelist (module_path);
-			return false;
+		};
+	}
+
+	if (jobs.size () < 2) {
+		/* nothing to parallelize */
+		return;
+	}
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("VST3: scanning %1 bundles concurrently\n", jobs.size ()));
+
+	run_scanner_apps (vst3_scanner_bin_path, _("VST3"), jobs);
+
+	for (std::vector<ScannerJob>::const_iterator i = jobs.begin (); i != jobs.end (); ++i) {
+		if (!i->completed) {
+			skip.insert (i->path);
+		} else if (!Glib::file_test (vst3_cache_file (module_path_vst3 (i->path)), Glib::FILE_TEST_EXISTS)) {
+			/* the module remains blacklisted */
+			i->psle->msg (PluginScanLogEntry::Error, _("Scan Failed."));
 		}
 	}
-	psle->msg (PluginScanLogEntry::OK, scan_log.str());
-	return true;
 }
 
 #endif // VST3_SUPPORT
@@ -0,0 +1,221 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+#include <glibmm/fileutils.h>
+
+#include "pbd/compose.h"
+#include "pbd/error.h"
+
+#include "ardour/debug.h"
+#include "ardour/plugin_scan_index.h"
+
+#include "pbd/i18n.h"
+
+using namespace ARDOUR;
+
+/* file format: magic, version, number of entries; followed by the entries:
+ * type (uint32), mtime, size, cache mtime, cache version (int64), path-length (uint32), path.
+ * Host byte-order, the file is a local cache.
+ */
+static const char     index_magic[4] = { 'A', 'P', 'S', 'I' };
+static const uint32_t index_version  = 2;
+
+PluginScanIndex::PluginScanIndex (std::string const& path)
+	: _path (path)
+	, _dirty (false)
+{
+}
+
+PluginScanIndex::Status
+PluginScanIndex::status (PluginType type, std::string const& module_path, std::string const& cache_file, int cache_version) const
+{
+	Index::const_iterator i = _index.find (Key (type, module_path));
+	if (i == _index.end ()) {
+		return Unknown;
+	}
+
+	GStatBuf sb_mod;
+	GStatBuf sb_cache;
+
+	if (g_stat (module_path.c_str (), &sb_mod) != 0) {
+		return Unknown;
+	}
+
+	if (sb_mod.st_mtime != i->second.module_mtime || sb_mod.st_size != i->second.module_size) {
+		return Modified;
+	}
+
+	if (g_stat (cache_file.c_str (), &sb_cache) != 0 || sb_cache.st_mtime != i->second.cache_mtime) {
+		return Unknown;
+	}
+
+	if (i->second.cache_version != cache_version) {
+		/* cache-file format changed, validate it */
+		return Unknown;
+	}
+
+	return Unchanged;
+}
+
+void
+PluginScanIndex::update (PluginType type, std::string const& module_path, std::string const& cache_file, int cache_version)
+{
+	GStatBuf sb_mod;
+	GStatBuf sb_cache;
+
+	if (g_stat (module_path.c_str (), &sb_mod) != 0 || g_stat (cache_file.c_str (), &sb_cache) != 0) {
+		remove (type, module_path);
+		return;
+	}
+
+	Entry e;
+	e.module_mtime  = sb_mod.st_mtime;
+	e.module_size   = sb_mod.st_size;
+	e.cache_mtime   = sb_cache.st_mtime;
+	e.cache_version = cache_version;
+
+	Index::iterator i = _index.find (Key (type, module_path));
+	if (i == _index.end ()) {
+		_index.insert (std::make_pair (Key (type, module_path), e));
+	} else if (0 != memcmp (&i->second, &e, sizeof (Entry))) {
+		i->second = e;
+	} else {
+		return;
+	}
+	_dirty = true;
+}
+
+void
+PluginScanIndex::remove (PluginType type, std::string const& module_path)
+{
+	if (_index.erase (Key (type, module_path)) > 0) {
+		_dirty = true;
+	}
+}
+
+bool
+PluginScanIndex::load ()
+{
+	_index.clear ();
+	_dirty = false;
+
+	if (!Glib::file_test (_path, Glib::FILE_TEST_EXISTS)) {
+		return false;
+	}
+
+	GError*      err = NULL;
+	GMappedFile* mf  = g_mapped_file_new (_path.c_str (), FALSE, &err);
+
+	if (!mf) {
+		PBD::warning << string_compose (_("Cannot open plugin scan index '%1': %2"), _path, err ? err->message : "") << endmsg;
+		if (err) {
+			g_error_free (err);
+		}
+		return false;
+	}
+
+	char const*  p   = g_mapped_file_get_contents (mf);
+	char const*  end = p + g_mapped_file_get_length (mf);
+	uint32_t     version;
+	uint32_t     count;
+	bool         ok = false;
+
+#define READ(dst) if (p + sizeof (dst) > end) { goto out; } memcpy (&dst, p, sizeof (dst)); p += sizeof (dst);
+
+	if (!p || p + sizeof (index_magic) > end || memcmp (p, index_magic, sizeof (index_magic))) {
+		goto out;
+	}
+	p += sizeof (index_magic);
+
+	READ (version);
+	if (version != index_version) {
+		goto out;
+	}
+	READ (count);
+
+	for (uint32_t n = 0; n < count; ++n) {
+		uint32_t type;
+		uint32_t len;
+		Entry    e;
+		READ (type);
+		READ (e.module_mtime);
+		READ (e.module_size);
+		READ (e.cache_mtime);
+		READ (e.cache_version);
+		READ (len);
+		if (p + len > end) {
+			goto out;
+		}
+		_index[Key ((PluginType) type, std::string (p, len))] = e;
+		p += len;
+	}
+	ok = true;
+
+#undef READ
+
+out:
+	g_mapped_file_unref (mf);
+
+	if (!ok) {
+		PBD::warning << string_compose (_("Ignored invalid plugin scan index '%1'"), _path) << endmsg;
+		_index.clear ();
+		_dirty = true;
+	}
+
+	DEBUG_TRACE (DEBUG::PluginManager, string_compose ("Loaded %1 entries from plugin scan index\n", _index.size ()));
+	return ok;
+}
+
+bool
+PluginScanIndex::save ()
+{
+	if (!_dirty) {
+		return true;
+	}
+
+	std::string data (index_magic, sizeof (index_magic));
+	uint32_t    count = _index.size ();
+
+	data.append ((char const*) &index_version, sizeof (index_version));
+	data.append ((char const*) &count, sizeof (count));
+
+	for (Index::const_iterator i = _index.begin (); i != _index.end (); ++i) {
+		uint32_t type = i->first.first;
+		uint32_t len  = i->first.second.size ();
+		data.append ((char const*) &type, sizeof (type));
+		data.append ((char const*) &i->second.module_mtime, sizeof (int64_t));
+		data.append ((char const*) &i->second.module_size, sizeof (int64_t));
+		data.append ((char const*) &i->second.cache_mtime, sizeof (int64_t));
+		data.append ((char const*) &i->second.cache_version, sizeof (int64_t));
+		data.append ((char const*) &len, sizeof (len));
+		data.append (i->first.second);
+	}
+
+	try {
+		/* writes a temporary file and renames it */
+		Glib::file_set_contents (_path, data);
+	} catch (Glib::FileError const& err) {
+		PBD::warning << string_compose (_("Cannot save plugin scan index '%1': %2"), _path, err.what ()) << endmsg;
+		return false;
+	}
+
+	_dirty = false;
+	return true;
+}
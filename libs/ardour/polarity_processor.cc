@@ -73,6 +73,33 @@ PolarityProcessor::run (BufferSet& bufs, samplepos_t /*start_sample*/, samplepos
 	}
 }
 
+bool
+PolarityProcessor::setup_gain_stage (BufferSet const& bufs)
+{
+	/* when inactive, fade all to unity */
+	check_active ();
+	return bufs.count().n_audio () <= _current_gain.size();
+}
+
+void
+PolarityProcessor::gain_stage (uint32_t chn, gain_t& current, gain_t& target) const
+{
+	current = _current_gain[chn];
+	target  = (_active && _control->inverted (chn)) ? -1.f : 1.f;
+}
+
+void
+PolarityProcessor::set_gain_stage (uint32_t chn, gain_t current)
+{
+	gain_t const target = (_active && _control->inverted (chn)) ? -1.f : 1.f;
+	/* see Amp::apply_gain */
+	if (fabsf (current - target) < GAIN_COEFF_DELTA) {
+		_current_gain[chn] = target;
+	} else {
+		_current_gain[chn] = current;
+	}
+}
+
 XMLNode&
 PolarityProcessor::state () const
 {
@@ -164,10 +164,11 @@ Port::port_connected_or_disconnected (std::weak_ptr<Port> w0, std::string n1, st
 {
 	std::shared_ptr<Port> p0 = w0.lock ();
 	std::shared_ptr<Port> p1 = w1.lock ();
-	/* a cheaper, less hacky way to do boost::shared_from_this() ...  */
-	std::shared_ptr<Port> pself = AudioEngine::instance()->get_port_by_name (name());
 
-	if (p0 == pself) {
+	/* This is called for every port on every connection change,
+	 * compare pointers rather than looking up this port by name.
+	 */
+	if (p0.get () == this) {
 		if (con) {
 			insert_connection (n2);
 		} else {
@@ -175,7 +176,7 @@ Port::port_connected_or_disconnected (std::weak_ptr<Port> w0, std::string n1, st
 		}
 		ConnectedOrDisconnected (p0, p1, con); // emit signal
 	}
-	if (p1 == pself) {
+	if (p1.get () == this) {
 		if (con) {
 			insert_connection (n1);
 		} else {
@@ -33,6 +33,7 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _rt_connections (new BackendPortList)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -97,6 +98,7 @@ void
 BackendPort::store_connection (BackendPortHandle port)
 {
 	_connections.insert (port);
+	update_rt_connections ();
 }
 
 int
@@ -126,6 +128,15 @@ void BackendPort::remove_connection (BackendPortHandle port)
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	update_rt_connections ();
+}
+
+void
+BackendPort::update_rt_connections ()
+{
+	std::shared_ptr<BackendPortList> c = _rt_connections.write_copy ();
+	c->assign (_connections.begin (), _connections.end ());
+	_rt_connections.update (c);
 }
 
 
@@ -137,6 +148,7 @@ void BackendPort::disconnect_all (BackendPortHandle self)
 		_backend.port_connect_callback (name(), (*it)->name(), false);
 		_connections.erase (it);
 	}
+	update_rt_connections ();
 }
 
 bool
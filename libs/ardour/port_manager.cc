@@ -108,6 +108,7 @@ PortManager::falloff_cache_calc (pframes_t n_samples, samplecnt_t rate)
 PortManager::AudioInputPort::AudioInputPort (samplecnt_t sz)
 	: scope (AudioPortScope (new CircularSampleBuffer (sz)))
 	, meter (AudioPortMeter (new DPM))
+	, active (InputPortActive (new std::atomic<bool> (false)))
 {
 }
 
@@ -146,6 +147,7 @@ PortManager::AudioInputPort::process (Sample const* buf, pframes_t n_samples, bo
 PortManager::MIDIInputPort::MIDIInputPort (samplecnt_t sz)
 	: monitor (MIDIPortMonitor (new CircularEventBuffer (sz)))
 	, meter (MIDIPortMeter (new MPM))
+	, active (InputPortActive (new std::atomic<bool> (false)))
 {
 }
 
@@ -253,9 +255,12 @@ PortManager::PortManager ()
 	: _ports (new Ports)
 	, _port_remove_in_progress (false)
 	, _port_deletions_pending (8192) /* ick, arbitrary sizing */
+	, _port_buffer_size (0)
 	, _midi_info_dirty (true)
 	, _audio_input_ports (new AudioInputPorts)
 	, _midi_input_ports (new MIDIInputPorts)
+	, _connection_batch_depth (0)
+	, _connection_batch_reorder (false)
 {
 	_reset_meters.store (1);
 	load_port_info ();
@@ -925,6 +930,8 @@ PortManager::reconnect_ports ()
 
 	DEBUG_TRACE (DEBUG::Ports, string_compose ("reconnect %1 ports\n", p->size ()));
 
+	ConnectionBatch cb (*this);
+
 	Session* s = AudioEngine::instance ()->session ();
 	if (s && s->master_out() && !s->master_out ()->output()->has_ext_connection()) {
 		s->auto_connect_master_bus ();
@@ -1001,12 +1008,126 @@ PortManager::connect_callback (const string& a, const string& b, bool conn)
 		}
 	}
 
+	if (!in_backend_process_thread ()) {
+		Glib::Threads::Mutex::Lock lm (_connection_batch_lock);
+		if (_connection_batch_depth > 0) {
+			_connection_batch.push_back (ConnectionChange (a, b, conn));
+			return;
+		}
+	}
+
 	PortConnectedOrDisconnected (
 	    port_a, a,
 	    port_b, b,
 	    conn); /* EMIT SIGNAL */
 }
 
+void
+PortManager::emit_connection_change (std::string const& a, std::string const& b, bool conn)
+{
+	std::shared_ptr<Port>        port_a;
+	std::shared_ptr<Port>        port_b;
+	Ports::const_iterator        x;
+	std::shared_ptr<Ports const> pr = _ports.reader ();
+
+	x = pr->find (make_port_name_relative (a));
+	if (x != pr->end ()) {
+		port_a = x->second;
+	}
+
+	x = pr->find (make_port_name_relative (b));
+	if (x != pr->end ()) {
+		port_b = x->second;
+	}
+
+	PortConnectedOrDisconnected (
+	    port_a, a,
+	    port_b, b,
+	    conn); /* EMIT SIGNAL */
+}
+
+/** @return true if called from the backend's process thread(s).
+ * Connection batches are never used there: the process thread does
+ * not open batches, and its notifications are not deferred, so that
+ * coalescing and emitting deferred signals only happens in the
+ * (non-realtime) thread which commits the batch.
+ */
+bool
+PortManager::in_backend_process_thread () const
+{
+	return _backend && _backend->in_process_thread ();
+}
+
+void
+PortManager::begin_connection_batch ()
+{
+	if (in_backend_process_thread ()) {
+		return;
+	}
+	Glib::Threads::Mutex::Lock lm (_connection_batch_lock);
+	++_connection_batch_depth;
+}
+
+void
+PortManager::commit_connection_batch ()
+{
+	std::vector<ConnectionChange> changes;
+	bool                          reorder;
+
+	if (in_backend_process_thread ()) {
+		return;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (_connection_batch_lock);
+		assert (_connection_batch_depth > 0);
+		if (--_connection_batch_depth > 0) {
+			return;
+		}
+		changes.swap (_connection_batch);
+		reorder                   = _connection_batch_reorder;
+		_connection_batch_reorder = false;
+	}
+
+	DEBUG_TRACE (DEBUG::BackendCallbacks, string_compose (X_("commit connection batch, %1 changes, reorder: %2\n"), changes.size (), reorder));
+
+	/* coalesce: a later change of the same pair of ports supersedes
+	 * an earlier one, and connecting then disconnecting (or vice versa)
+	 * is no net change.
+	 */
+	typedef std::map<std::pair<std::string, std::string>, size_t> ChangeIndex;
+
+	ChangeIndex       idx;
+	std::vector<bool> valid (changes.size (), true);
+
+	for (size_t i = 0; i < changes.size (); ++i) {
+		ConnectionChange const& c (changes[i]);
+		std::pair<std::string, std::string> key = c.a < c.b ? std::make_pair (c.a, c.b) : std::make_pair (c.b, c.a);
+		ChangeIndex::iterator it = idx.find (key);
+		if (it == idx.end ()) {
+			idx[key] = i;
+			continue;
+		}
+		valid[it->second] = false;
+		if (changes[it->second].connected != c.connected) {
+			valid[i] = false;
+			idx.erase (it);
+		} else {
+			it->second = i;
+		}
+	}
+
+	for (size_t i = 0; i < changes.size (); ++i) {
+		if (valid[i]) {
+			emit_connection_change (changes[i].a, changes[i].b, changes[i].connected);
+		}
+	}
+
+	if (reorder && !_port_remove_in_progress) {
+		GraphReordered (); /* EMIT SIGNAL */
+	}
+}
+
 void
 PortManager::registration_callback ()
 {
@@ -1151,6 +1272,14 @@ PortManager::update_input_ports (bool clear)
 		}
 	}
 
+	if (!new_audio.empty () || !new_midi.empty () || clear) {
+		/* apply existing subscriptions to new ports */
+		Glib::Threads::Mutex::Lock lm (_input_meter_lock);
+		for (std::map<std::string, int>::const_iterator i = _input_meter_subscriptions.begin (); i != _input_meter_subscriptions.end (); ++i) {
+			activate_input_meter (i->first, true);
+		}
+	}
+
 	if (clear) {
 		/* don't send notification for initial setup.
 		 * Physical I/O is initially connected in
@@ -1248,6 +1377,14 @@ PortManager::graph_order_callback ()
 {
 	DEBUG_TRACE (DEBUG::BackendCallbacks, "graph order callback\n");
 
+	if (!in_backend_process_thread ()) {
+		Glib::Threads::Mutex::Lock lm (_connection_batch_lock);
+		if (_connection_batch_depth > 0) {
+			_connection_batch_reorder = true;
+			return 0;
+		}
+	}
+
 	if (!_port_remove_in_progress) {
 		GraphReordered (); /* EMIT SIGNAL */
 	}
@@ -1285,6 +1422,14 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 	 *    A single external source-port may be connected to many ardour
 	 *    input-ports. Currently re-sampling is per input.
 	 */
+
+	/* phase and filter coefficients are shared by all ports,
+	 * compute them once, before ports resample their data. */
+	_input_src.inp_count = nframes;
+	_input_src.out_count = Port::cycle_nframes ();
+	_input_src.set_rratio (Port::cycle_nframes () / (double)nframes);
+	_input_src.prepare ();
+
 	std::shared_ptr<RTTaskList> tl;
 	if (s) {
 		tl = s->rt_tasklist ();
@@ -1311,6 +1456,11 @@ void
 PortManager::cycle_end (pframes_t nframes, Session* s)
 {
 	// see optimzation note in ::cycle_start()
+	_output_src.inp_count = Port::cycle_nframes ();
+	_output_src.out_count = nframes;
+	_output_src.set_rratio (nframes / (double)Port::cycle_nframes ());
+	_output_src.prepare ();
+
 	std::shared_ptr<RTTaskList> tl;
 	if (s) {
 		tl = s->rt_tasklist ();
@@ -1366,6 +1516,12 @@ PortManager::silence (pframes_t nframes, Session* s)
 void
 PortManager::reinit (bool with_ratio)
 {
+	if (with_ratio) {
+		setup_resamplers ();
+	}
+	_input_src.reset ();
+	_output_src.reset ();
+
 	for (auto const& p : *_ports.reader ()) {
 		p.second->reinit (with_ratio);
 	}
@@ -1429,6 +1585,11 @@ void
 PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t nframes, Session* s)
 {
 	// see optimzation note in ::cycle_start()
+	_output_src.inp_count = Port::cycle_nframes ();
+	_output_src.out_count = nframes;
+	_output_src.set_rratio (nframes / (double)Port::cycle_nframes ());
+	_output_src.prepare ();
+
 	std::shared_ptr<RTTaskList> tl;
 	if (s) {
 		tl = s->rt_tasklist ();
@@ -1912,6 +2073,21 @@ PortManager::set_port_buffer_sizes (pframes_t n)
 		p.second->set_buffer_size (n);
 	}
 	_monitor_port.set_buffer_size (n);
+
+	_port_buffer_size = n;
+	setup_resamplers ();
+}
+
+void
+PortManager::setup_resamplers ()
+{
+	/* must not be called concurrently with processing */
+	pframes_t maxout = std::max<pframes_t> (_port_buffer_size, floor (_port_buffer_size * Config->get_max_transport_speed ()));
+
+	_input_src.setup (Port::resampler_quality (), maxout);
+	_input_src.set_rrfilt (10);
+	_output_src.setup (Port::resampler_quality (), maxout);
+	_output_src.set_rrfilt (10);
 }
 
 bool
@@ -1952,6 +2128,46 @@ PortManager::reset_input_meters ()
 	_reset_meters.store (1);
 }
 
+void
+PortManager::subscribe_input_meter (std::string const& port_name)
+{
+	Glib::Threads::Mutex::Lock lm (_input_meter_lock);
+	if (++_input_meter_subscriptions[port_name] == 1) {
+		activate_input_meter (port_name, true);
+	}
+}
+
+void
+PortManager::unsubscribe_input_meter (std::string const& port_name)
+{
+	Glib::Threads::Mutex::Lock lm (_input_meter_lock);
+	std::map<std::string, int>::iterator i = _input_meter_subscriptions.find (port_name);
+	if (i == _input_meter_subscriptions.end ()) {
+		assert (0);
+		return;
+	}
+	if (--i->second == 0) {
+		_input_meter_subscriptions.erase (i);
+		activate_input_meter (port_name, false);
+	}
+}
+
+void
+PortManager::activate_input_meter (std::string const& port_name, bool yn)
+{
+	std::shared_ptr<AudioInputPorts const> aip = _audio_input_ports.reader ();
+	AudioInputPorts::const_iterator a = aip->find (port_name);
+	if (a != aip->end ()) {
+		a->second.active->store (yn);
+	}
+
+	std::shared_ptr<MIDIInputPorts const> mip = _midi_input_ports.reader ();
+	MIDIInputPorts::const_iterator m = mip->find (port_name);
+	if (m != mip->end ()) {
+		m->second.active->store (yn);
+	}
+}
+
 PortManager::AudioInputPorts
 PortManager::audio_input_ports () const
 {
@@ -1985,6 +2201,12 @@ PortManager::run_input_meters (pframes_t n_samples, samplecnt_t rate)
 		assert (!port_is_mine (p.first));
 		AudioInputPort& ai = *const_cast<AudioInputPort*>(&p.second);
 
+		if (!ai.active->load (std::memory_order_relaxed)) {
+			/* nobody is watching, start from scratch when subscribed */
+			ai.meter->reset ();
+			continue;
+		}
+
 		ai.apply_falloff (n_samples, rate, reset);
 
 		PortEngine::PortHandle ph = _backend->get_port_by_name (p.first);
@@ -2007,12 +2229,18 @@ PortManager::run_input_meters (pframes_t n_samples, samplecnt_t rate)
 	for (auto const& p : *mip) {
 		assert (!port_is_mine (p.first));
 
+		MIDIInputPort& mi = *const_cast<MIDIInputPort*>(&p.second);
+
+		if (!mi.active->load (std::memory_order_relaxed)) {
+			mi.meter->reset ();
+			continue;
+		}
+
 		PortEngine::PortHandle ph = _backend->get_port_by_name (p.first);
 		if (!ph) {
 			continue;
 		}
 
-		MIDIInputPort& mi = *const_cast<MIDIInputPort*>(&p.second);
 		mi.apply_falloff (n_samples, rate, reset);
 
 		void*           buffer      = _backend->get_buffer (ph, n_samples);
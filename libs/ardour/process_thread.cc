@@ -56,9 +56,9 @@ ProcessThread::~ProcessThread ()
 }
 
 void
-ProcessThread::get_buffers ()
+ProcessThread::get_buffers (bool local)
 {
-	ThreadBuffers* tb = BufferManager::get_thread_buffers ();
+	ThreadBuffers* tb = BufferManager::get_thread_buffers (local);
 
 	assert (tb);
 	_private_thread_buffers.set (tb);
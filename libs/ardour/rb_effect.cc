@@ -20,14 +20,18 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <vector>
 
 #include <glibmm.h>
 
 #include <rubberband/RubberBandStretcher.h>
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/progress.h"
+#include "pbd/pthread_utils.h"
 
 #include "ardour/audioregion.h"
 #include "ardour/audiosource.h"
@@ -201,6 +205,13 @@ RBEffect::run (std::shared_ptr<Region> r, Progress* progress)
 		goto out;
 	}
 
+	if (tsr.segment_length > 0 && read_duration > 2 * tsr.segment_length) {
+		if (run_segmented (region, nsrcs, read_start, read_duration, stretch, shift, progress)) {
+			goto out;
+		}
+		goto done;
+	}
+
 	gain_buffer = new gain_t[bufsize];
 	buffers     = new float*[channels];
 
@@ -336,6 +347,7 @@ RBEffect::run (std::shared_ptr<Region> r, Progress* progress)
 		goto out;
 	}
 
+done:
 	new_name = region->name ();
 	at       = new_name.find ('@');
 
@@ -394,3 +406,257 @@ out:
 
 	return ret;
 }
+
+namespace {
+
+/** One overlapping part of a region, stretched independently */
+struct StretchSegment {
+	StretchSegment (samplepos_t s, samplecnt_t l, samplecnt_t ol)
+		: in_start (s)
+		, in_len (l)
+		, out_len (ol)
+		, status (-1)
+	{}
+
+	samplepos_t in_start; ///< offset relative to read_start
+	samplecnt_t in_len;
+	samplecnt_t out_len;
+	int         status;
+
+	std::vector<std::vector<Sample> > out;
+};
+
+struct StretchContext {
+	std::shared_ptr<AudioRegion> region;
+	TimeFXRequest*               tsr;
+	samplepos_t                  read_start;
+	samplecnt_t                  sample_rate;
+	double                       stretch;
+	double                       shift;
+	std::atomic<samplecnt_t>     work_done;
+	std::atomic<int>             n_complete;
+};
+
+}
+
+static void
+stretch_segment (StretchContext* ctx, StretchSegment* seg)
+{
+	const samplecnt_t bufsize  = 8192;
+	const uint32_t    channels = ctx->region->n_channels ();
+
+	std::vector<std::vector<Sample> > buf (channels, std::vector<Sample> (bufsize));
+	std::vector<Sample*>              buffers (channels);
+	std::vector<gain_t>               gain_buffer (bufsize);
+
+	for (uint32_t c = 0; c < channels; ++c) {
+		buffers[c] = &buf[c][0];
+	}
+
+	seg->out.resize (channels);
+	for (uint32_t c = 0; c < channels; ++c) {
+		seg->out[c].reserve (seg->out_len + bufsize);
+	}
+
+	std::shared_ptr<AudioRegion> region = ctx->region;
+
+	try {
+		RubberBandStretcher stretcher (ctx->sample_rate, channels,
+		                               (RubberBandStretcher::Options)ctx->tsr->opts,
+		                               ctx->stretch, ctx->shift);
+
+		stretcher.setExpectedInputDuration (seg->in_len);
+		stretcher.setMaxProcessSize (bufsize);
+
+		for (int pass = 0; pass < 2; ++pass) {
+			samplecnt_t pos = 0;
+			while (pos < seg->in_len && !ctx->tsr->cancel) {
+				samplecnt_t this_time = min (bufsize, seg->in_len - pos);
+				if (pass == 1) {
+					this_time = min (this_time, (samplecnt_t)stretcher.getSamplesRequired ());
+				}
+
+				samplepos_t this_position = ctx->read_start + seg->in_start + pos - region->start_sample () + region->position_sample ();
+
+				for (uint32_t c = 0; c < channels; ++c) {
+					if (region->master_read_at (buffers[c], buffers[c], &gain_buffer[0], this_position, this_time, c) != this_time) {
+						error << string_compose (_("tempoize: error reading data from %1 at %2 (wanted %3)"),
+						                         region->name (), this_position, this_time)
+						      << endmsg;
+						ctx->n_complete.fetch_add (1);
+						return;
+					}
+				}
+
+				pos += this_time;
+				ctx->work_done.fetch_add (this_time);
+
+				if (pass == 0) {
+					stretcher.study (&buffers[0], this_time, pos == seg->in_len);
+					continue;
+				}
+
+				stretcher.process (&buffers[0], this_time, pos == seg->in_len);
+
+				samplecnt_t avail;
+				while ((avail = stretcher.available ()) > 0) {
+					samplecnt_t n = stretcher.retrieve (&buffers[0], min (bufsize, avail));
+					for (uint32_t c = 0; c < channels; ++c) {
+						seg->out[c].insert (seg->out[c].end (), buffers[c], buffers[c] + n);
+					}
+				}
+			}
+		}
+
+		/* completing */
+		samplecnt_t avail;
+		while ((avail = stretcher.available ()) >= 0 && !ctx->tsr->cancel) {
+			if (avail == 0) {
+				/* wait for stretcher threads */
+				Glib::usleep (10000);
+				continue;
+			}
+			samplecnt_t n = stretcher.retrieve (&buffers[0], min (bufsize, avail));
+			for (uint32_t c = 0; c < channels; ++c) {
+				seg->out[c].insert (seg->out[c].end (), buffers[c], buffers[c] + n);
+			}
+		}
+	} catch (runtime_error& err) {
+		error << err.what () << endmsg;
+		ctx->n_complete.fetch_add (1);
+		return;
+	}
+
+	/* the stretcher's output length may differ by a few samples,
+	 * segments must align exactly to be cross-faded */
+	for (uint32_t c = 0; c < channels; ++c) {
+		seg->out[c].resize (seg->out_len, 0.f);
+	}
+
+	seg->status = ctx->tsr->cancel ? -1 : 0;
+	ctx->n_complete.fetch_add (1);
+}
+
+/** Stretch a long region in overlapping segments, processing several
+ * segments concurrently. Output of adjacent segments is linearly
+ * cross-faded in the overlap, and written to the new sources in order.
+ */
+int
+RBEffect::run_segmented (std::shared_ptr<AudioRegion> region, SourceList& nsrcs, samplepos_t read_start, samplecnt_t read_duration, double stretch, double shift, Progress* progress)
+{
+	const samplecnt_t seg_len  = tsr.segment_length;
+	const samplecnt_t overlap  = min<samplecnt_t> (seg_len / 4, session.sample_rate () / 2);
+	const uint32_t    channels = region->n_channels ();
+	/* the last segment also includes the remainder */
+	const uint32_t    n_segs   = read_duration / seg_len;
+	const uint32_t    n_par    = max<uint32_t> (1, hardware_concurrency ());
+
+	StretchContext ctx;
+	ctx.region      = region;
+	ctx.tsr         = &tsr;
+	ctx.read_start  = read_start;
+	ctx.sample_rate = session.sample_rate ();
+	ctx.stretch     = stretch;
+	ctx.shift       = shift;
+	ctx.work_done.store (0);
+
+	/* map input to output position */
+#define OUTPOS(p) ((samplecnt_t)llrint ((p) * stretch))
+
+	/* every segment is studied and processed, once */
+	const samplecnt_t total_work = 2 * (read_duration + 2 * overlap * (n_segs - 1));
+
+	std::vector<std::vector<Sample> > carry (channels);
+	std::vector<Sample>               mix;
+
+	progress->set_progress (0);
+
+	for (uint32_t first = 0; first < n_segs && !tsr.cancel; first += n_par) {
+
+		uint32_t const last = min (n_segs, first + n_par);
+
+		std::vector<StretchSegment*> segs;
+		for (uint32_t j = first; j < last; ++j) {
+			samplepos_t const a = j > 0 ? j * seg_len - overlap : 0;
+			samplepos_t const b = j + 1 < n_segs ? (j + 1) * seg_len + overlap : read_duration;
+			segs.push_back (new StretchSegment (a, b - a, OUTPOS (b) - OUTPOS (a)));
+		}
+
+		ctx.n_complete.store (0);
+
+		std::vector<PBD::Thread*> threads;
+		for (std::vector<StretchSegment*>::const_iterator i = segs.begin (); i != segs.end (); ++i) {
+			threads.push_back (PBD::Thread::create (boost::bind (&stretch_segment, &ctx, *i), "TimeFX"));
+		}
+
+		while (ctx.n_complete.load () < (int)segs.size ()) {
+			Glib::usleep (50000);
+			progress->set_progress ((float)ctx.work_done.load () / total_work);
+		}
+
+		for (std::vector<PBD::Thread*>::const_iterator i = threads.begin (); i != threads.end (); ++i) {
+			(*i)->join ();
+			delete *i;
+		}
+
+		/* write segments in order */
+		int rv = 0;
+		for (uint32_t j = first; j < last && rv == 0; ++j) {
+			StretchSegment* seg = segs[j - first];
+			if (seg->status) {
+				rv = -1;
+				break;
+			}
+
+			samplepos_t const a_out = OUTPOS (seg->in_start);
+			/* start of the overlap with the next segment */
+			samplecnt_t const next  = j + 1 < n_segs ? OUTPOS ((j + 1) * seg_len - overlap) - a_out : seg->out_len;
+			/* length of the overlap with the previous segment */
+			samplecnt_t const xfade = j > 0 ? OUTPOS (j * seg_len + overlap) - a_out : 0;
+
+			for (uint32_t c = 0; c < channels && rv == 0; ++c) {
+				Sample const* out = &seg->out[c][0];
+				std::shared_ptr<AudioSource> asrc = std::dynamic_pointer_cast<AudioSource> (nsrcs[c]);
+				if (!asrc) {
+					continue;
+				}
+				assert ((samplecnt_t)carry[c].size () == xfade);
+
+				if (xfade > 0) {
+					mix.resize (xfade);
+					for (samplecnt_t k = 0; k < xfade; ++k) {
+						float const g = (k + .5f) / xfade;
+						mix[k] = carry[c][k] * (1.f - g) + out[k] * g;
+					}
+					if (asrc->write (&mix[0], xfade) != xfade) {
+						rv = -1;
+					}
+				}
+
+				if (rv == 0 && next > xfade && asrc->write (out + xfade, next - xfade) != next - xfade) {
+					rv = -1;
+				}
+
+				if (rv) {
+					error << string_compose (_("error writing tempo-adjusted data to %1"), nsrcs[c]->name ()) << endmsg;
+				}
+
+				/* keep the tail, to cross-fade with the next segment */
+				carry[c].assign (out + next, out + seg->out_len);
+			}
+		}
+
+		for (std::vector<StretchSegment*>::const_iterator i = segs.begin (); i != segs.end (); ++i) {
+			delete *i;
+		}
+
+		if (rv) {
+			return -1;
+		}
+	}
+
+#undef OUTPOS
+
+	progress->set_progress (1.0);
+	return tsr.cancel ? -1 : 0;
+}
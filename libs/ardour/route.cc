@@ -126,6 +126,7 @@ Route::Route (Session& sess, string name, PresentationInfo::Flag flag, DataType
 	, _meter_point (MeterPostFader)
 	, _pending_meter_point (MeterPostFader)
 	, _denormal_protection (false)
+	, _pipelined (false)
 	, _recordable (true)
 	, _have_internal_generator (false)
 	, _default_type (default_type)
@@ -510,10 +511,21 @@ Route::process_output_buffers (BufferSet& bufs,
 	   and go ....
 	   ----------------------------------------------------------------------------------------- */
 
-	samplecnt_t latency = 0;
+	/* the data of a pipelined route is one cycle late */
+	samplecnt_t latency = _pipelined ? _pipeline.delay () : 0;
 
 	for (ProcessorList::const_iterator i = _processors.begin(); i != _processors.end(); ++i) {
 
+		if (_pipelined && (*i) == _intreturn) {
+			/* sends were collected by ::pipeline_capture */
+			continue;
+		}
+
+		if (run_gain_stages (bufs, nframes, i)) {
+			/* gain stages have no latency */
+			continue;
+		}
+
 		bool re_inject_oob_data = false;
 		if ((*i) == _disk_reader) {
 			/* ignore port-count from prior plugins, use DR's count.
@@ -585,6 +597,86 @@ Route::process_output_buffers (BufferSet& bufs,
 	}
 }
 
+/** Apply consecutive gain stages (trim, polarity, fader) in a single pass.
+ * On success @a i is advanced to the last processor that was applied.
+ */
+bool
+Route::run_gain_stages (BufferSet& bufs, pframes_t nframes, ProcessorList::const_iterator& i)
+{
+	GainStage* stages[4];
+	uint32_t   n_stages = 0;
+
+	ProcessorList::const_iterator last = i;
+
+	for (ProcessorList::const_iterator j = i; j != _processors.end () && n_stages < 4; ++j) {
+		if (*j == _trim || *j == _amp) {
+			stages[n_stages++] = static_cast<Amp*> (j->get ());
+		} else if (*j == _polarity) {
+			stages[n_stages++] = _polarity.get ();
+		} else if (_volume && *j == _volume) {
+			stages[n_stages++] = _volume.get ();
+		} else {
+			break;
+		}
+		last = j;
+	}
+
+	if (n_stages < 2 || bufs.count ().n_audio () == 0) {
+		return false;
+	}
+
+	for (uint32_t s = 0; s < n_stages; ++s) {
+		if (!stages[s]->setup_gain_stage (bufs)) {
+			return false;
+		}
+	}
+
+	const gain_t a = 156.825f / (gain_t)_session.nominal_sample_rate (); // 25 Hz LPF, see Amp::apply_gain
+
+	uint32_t chn = 0;
+	for (BufferSet::audio_iterator b = bufs.audio_begin (); b != bufs.audio_end (); ++b, ++chn) {
+		gain_t cur[4];
+		gain_t tgt[4];
+		bool   lpf[4];
+		gain_t g    = GAIN_COEFF_UNITY;
+		bool   ramp = false;
+
+		for (uint32_t s = 0; s < n_stages; ++s) {
+			stages[s]->gain_stage (chn, cur[s], tgt[s]);
+			lpf[s] = cur[s] != tgt[s];
+			if (lpf[s]) {
+				ramp = true;
+			} else {
+				g *= tgt[s];
+			}
+		}
+
+		if (!ramp) {
+			Amp::apply_simple_gain (*b, nframes, g);
+		} else {
+			/* combined de-click, each stage's gain follows its own LPF */
+			Sample* const sp = b->data ();
+			for (pframes_t nx = 0; nx < nframes; ++nx) {
+				gain_t gn = g;
+				for (uint32_t s = 0; s < n_stages; ++s) {
+					if (lpf[s]) {
+						gn     *= cur[s];
+						cur[s] += a * (tgt[s] - cur[s]);
+					}
+				}
+				sp[nx] *= gn;
+			}
+		}
+
+		for (uint32_t s = 0; s < n_stages; ++s) {
+			stages[s]->set_gain_stage (chn, cur[s]);
+		}
+	}
+
+	i = last;
+	return true;
+}
+
 void
 Route::bounce_process (BufferSet& buffers, samplepos_t start, samplecnt_t nframes,
 		std::shared_ptr<Processor> endpoint,
@@ -738,10 +830,15 @@ Route::run_route (samplepos_t start_sample, samplepos_t end_sample, pframes_t nf
 {
 	BufferSet& bufs (_session.get_route_buffers (n_process_buffers()));
 
-	fill_buffers_with_input (bufs, _input, nframes);
+	if (_pipelined) {
+		/* input was captured at the end of the previous cycle, see ::pipeline_capture */
+		_pipeline.read (bufs, nframes);
+	} else {
+		fill_buffers_with_input (bufs, _input, nframes);
 
-	/* filter captured data before meter sees it */
-	filter_input (bufs);
+		/* filter captured data before meter sees it */
+		filter_input (bufs);
+	}
 
 	if (is_monitor()) {
 		/* control/monitor bus ignores input ports when something is
@@ -2056,6 +2153,7 @@ Route::configure_processors_unlocked (ProcessorStreams* err, Glib::Threads::RWLo
 	   configuration
 	*/
 	_session.ensure_buffers (n_process_buffers ());
+	configure_pipeline ();
 
 	DEBUG_TRACE (DEBUG::Processors, string_compose ("%1: configuration complete\n", _name));
 
@@ -2609,6 +2707,7 @@ Route::state (bool save_template) const
 
 	node->set_property (X_("active"), _active);
 	node->set_property (X_("denormal-protection"), _denormal_protection);
+	node->set_property (X_("pipelined"), _pipelined);
 	node->set_property (X_("meter-point"), _meter_point);
 	node->set_property (X_("disk-io-point"), _disk_io_point);
 
@@ -2837,6 +2936,11 @@ Route::set_state (const XMLNode& node, int version)
 		set_denormal_protection (denormal_protection);
 	}
 
+	bool pipelined;
+	if (node.get_property (X_("pipelined"), pipelined)) {
+		set_pipelined (pipelined);
+	}
+
 	/* convert old 3001 state */
 	std::string phase_invert_str;
 	if (node.get_property (X_("phase-invert"), phase_invert_str)) {
@@ -4460,7 +4564,10 @@ Route::update_signal_latency (bool apply_to_delayline, bool* delayline_update_ne
 
 	Glib::Threads::RWLock::ReaderLock lm (_processor_lock);
 
-	samplecnt_t l_in  = 0;
+	/* a pipelined route delays its input by one cycle */
+	const samplecnt_t l_pipe = _pipelined ? _pipeline.delay () : 0;
+
+	samplecnt_t l_in  = l_pipe;
 	samplecnt_t l_out = 0;
 	for (ProcessorList::reverse_iterator i = _processors.rbegin(); i != _processors.rend(); ++i) {
 		if (std::shared_ptr<LatentSend> snd = std::dynamic_pointer_cast<LatentSend> (*i)) {
@@ -4480,6 +4587,8 @@ Route::update_signal_latency (bool apply_to_delayline, bool* delayline_update_ne
 		}
 	}
 
+	l_out += l_pipe;
+
 	DEBUG_TRACE (DEBUG::LatencyRoute, string_compose ("%1: internal signal latency = %2\n", _name, l_out));
 
 	_signal_latency = l_out;
@@ -4583,6 +4692,7 @@ Route::set_block_size (pframes_t nframes)
 	lm.release ();
 
 	_session.ensure_buffers (n_process_buffers ());
+	configure_pipeline ();
 }
 
 void
@@ -4814,6 +4924,68 @@ Route::denormal_protection () const
 	return _denormal_protection;
 }
 
+bool
+Route::set_pipelined (bool yn)
+{
+	if (yn && (is_track () || is_monitor () || is_auditioner ())) {
+		return false;
+	}
+
+	if (_pipelined == yn) {
+		return true;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lx (AudioEngine::instance()->process_lock ());
+		_pipelined = yn;
+		configure_pipeline ();
+	}
+
+	pipelined_changed (); /* EMIT SIGNAL */
+
+	/* re-chain the process graph, and update latency */
+	processors_changed (RouteProcessorChange ()); /* EMIT SIGNAL */
+	_session.set_dirty ();
+	return true;
+}
+
+void
+Route::configure_pipeline ()
+{
+	/* Caller must hold process lock */
+	if (_pipelined) {
+		_pipeline.configure (n_process_buffers (), AudioEngine::instance ()->samples_per_cycle ());
+	}
+}
+
+/** Called by the Session after all routes have been processed,
+ * when the input ports and sends of this route hold the data of
+ * the current cycle.
+ */
+void
+Route::pipeline_capture (pframes_t nframes)
+{
+	if (!_pipelined) {
+		return;
+	}
+
+	Glib::Threads::RWLock::ReaderLock lm (_processor_lock, Glib::Threads::TRY_LOCK);
+
+	if (!lm.locked () || !_active) {
+		return;
+	}
+
+	BufferSet& bufs (_session.get_route_buffers (n_process_buffers ()));
+
+	fill_buffers_with_input (bufs, _input, nframes);
+
+	if (_intreturn) {
+		_intreturn->run (bufs, 0, 0, 1.0, nframes, true);
+	}
+
+	_pipeline.write (bufs, nframes);
+}
+
 void
 Route::set_active (bool yn, void* src)
 {
@@ -25,6 +25,7 @@ RTTaskList::RTTaskList (std::shared_ptr<Graph> process_graph)
 	: _graph (process_graph)
 {
 	_tasks.reserve (256);
+	_next.store (0);
 }
 
 void
@@ -45,3 +46,24 @@ RTTaskList::process ()
 	}
 	_tasks.clear ();
 }
+
+void
+RTTaskList::process_nested ()
+{
+	if (!_graph->process_nested_tasklist (*this)) {
+		for (auto const& fn : _tasks) {
+			fn._f ();
+		}
+	}
+}
+
+bool
+RTTaskList::run_next ()
+{
+	size_t n = _next.fetch_add (1);
+	if (n >= _tasks.size ()) {
+		return false;
+	}
+	_tasks[n]._f ();
+	return true;
+}
@@ -329,6 +329,7 @@ Session::Session (AudioEngine &eng,
 	, have_looped (false)
 	, _step_editors (0)
 	,  _speakers (new Speakers)
+	, _route_graph_edges (new GraphEdges)
 	, _ignore_route_processor_changes (0)
 	, _ignored_a_processor_change (0)
 	, midi_clock (0)
@@ -354,6 +355,7 @@ Session::Session (AudioEngine &eng,
 	_have_rec_enabled_track.store (0);
 	_have_rec_disabled_track.store (1);
 	_latency_recompute_pending.store (0);
+	_latency_dirty_all = false;
 	_suspend_timecode_transmission.store (0);
 	_update_pretty_names.store (0);
 	_seek_counter.store (0);
@@ -711,7 +713,7 @@ Session::destroy ()
 
 	/* drop GraphNode references */
 	_graph_chain.reset ();
-	_current_route_graph = GraphEdges ();
+	set_current_route_graph (GraphEdges (), std::set<GraphVertex> ());
 
 	_io_graph_chain[0].reset ();
 	_io_graph_chain[1].reset ();
@@ -815,6 +817,9 @@ Session::destroy ()
 		sources.clear ();
 	}
 
+	/* clip data retained for re-use is keyed by source IDs, which are meaningless now */
+	AudioClipCache::clear ();
+
 	/* not strictly necessary, but doing it here allows the shared_ptr debugging to work */
 	_playlists.reset ();
 
@@ -2421,7 +2426,7 @@ Session::set_block_size (pframes_t nframes)
 
 
 void
-Session::resort_routes ()
+Session::resort_routes (std::weak_ptr<Route> changed)
 {
 	/* don't do anything here with signals emitted
 	   by Routes during initial setup or while we
@@ -2430,8 +2435,7 @@ Session::resort_routes ()
 
 	if (inital_connect_or_deletion_in_progress ()) {
 		/* drop any references during delete */
-		GraphEdges edges;
-		_current_route_graph = edges;
+		set_current_route_graph (GraphEdges (), std::set<GraphVertex> ());
 		return;
 	}
 
@@ -2442,7 +2446,7 @@ Session::resort_routes ()
 	{
 		RCUWriter<RouteList> writer (routes);
 		std::shared_ptr<RouteList> r = writer.get_copy ();
-		resort_routes_using (r);
+		resort_routes_using (r, changed.lock ());
 		/* writer goes out of scope and forces update */
 	}
 
@@ -2463,10 +2467,12 @@ Session::resort_routes ()
 /** This is called whenever we need to rebuild the graph of how we will process
  *  routes.
  *  @param r List of routes, in any order.
+ *  @param changed if set, only the connections of this route changed
+ *  since the last call.
  */
 
 void
-Session::resort_routes_using (std::shared_ptr<RouteList> r)
+Session::resort_routes_using (std::shared_ptr<RouteList> r, std::shared_ptr<Route> changed)
 {
 #ifndef NDEBUG
 	Timing t;
@@ -2479,7 +2485,7 @@ Session::resort_routes_using (std::shared_ptr<RouteList> r)
 
 	bool ok = true;
 
-	if (rechain_process_graph (gnl)) {
+	if (rechain_process_graph (gnl, changed)) {
 		/* Update routelist for single-threaded processing, use topologically sorted nodelist */
 		r->clear ();
 		for (auto const& nd : gnl) {
@@ -2548,7 +2554,7 @@ Session::resort_io_plugs ()
 }
 
 bool
-Session::rechain_process_graph (GraphNodeList& g)
+Session::rechain_process_graph (GraphNodeList& g, std::shared_ptr<Route> changed)
 {
 	/* This may be called from the GUI thread (concurrrently with processing),
 	 * when a user adds/removes routes.
@@ -2557,7 +2563,34 @@ Session::rechain_process_graph (GraphNodeList& g)
 	 * In that case processing is blocked until the graph change is handled.
 	 */
 	GraphEdges edges;
-	if (topological_sort (g, edges)) {
+	bool       sorted = false;
+
+	if (changed && _current_route_graph_nodes.size () == g.size () && _current_route_graph_nodes.find (changed) != _current_route_graph_nodes.end ()) {
+		std::set<GraphVertex> nodes (g.begin (), g.end ());
+		if (nodes == _current_route_graph_nodes) {
+			/* Only edges to and from the changed route need to be looked up,
+			 * all others are retained from the current graph.
+			 */
+			GraphNodeList gnl (g);
+			std::set<GraphVertex> c;
+			c.insert (changed);
+			sorted = topological_sort (gnl, edges, _current_route_graph, c);
+			if (sorted) {
+				g.swap (gnl);
+			} else {
+				/* verify feedback using the complete graph, the
+				 * current graph may not be up to date */
+				edges = GraphEdges ();
+			}
+			DEBUG_TRACE (DEBUG::Graph, string_compose ("Incremental graph sort for '%1' %2\n", changed->name (), sorted ? "succeeded" : "failed"));
+		}
+	}
+
+	if (!sorted) {
+		sorted = topological_sort (g, edges);
+	}
+
+	if (sorted) {
 		/* We got a satisfactory topological sort, so there is no feedback;
 		 * use this new graph.
 		 *
@@ -2578,7 +2611,7 @@ Session::rechain_process_graph (GraphNodeList& g)
 			_graph_chain.reset ();
 		}
 
-		_current_route_graph = edges;
+		set_current_route_graph (edges, std::set<GraphVertex> (g.begin (), g.end ()));
 
 		return true;
 	}
@@ -2586,6 +2619,25 @@ Session::rechain_process_graph (GraphNodeList& g)
 	return false;
 }
 
+/** Called from the thread that re-sorts routes */
+void
+Session::set_current_route_graph (GraphEdges const& edges, std::set<GraphVertex> const& nodes)
+{
+	_current_route_graph       = edges;
+	_current_route_graph_nodes = nodes;
+
+	{
+		RCUWriter<GraphEdges>       writer (_route_graph_edges);
+		std::shared_ptr<GraphEdges> g = writer.get_copy ();
+		*g = edges;
+	}
+
+	/* readers hold a reference to the copy they use, old copies
+	 * must not keep routes alive.
+	 */
+	_route_graph_edges.flush ();
+}
+
 bool
 Session::rechain_ioplug_graph (bool pre)
 {
@@ -3166,6 +3218,9 @@ Session::new_route_from_template (uint32_t how_many, PresentationInfo::order_t i
 	*/
 	Stateful::ForceIDRegeneration force_ids;
 
+	/* notify about port connections of all new routes at once */
+	PortManager::ConnectionBatch connection_batch (_engine);
+
 	/* New v6 templates do have a version in the Route-Template,
 	 * we assume that all older, unversioned templates are
 	 * from Ardour 5.x
@@ -3527,8 +3582,8 @@ Session::add_routes_inner (RouteList& new_routes, bool input_auto_connect, bool
 			r->solo_isolate_control()->Changed.connect_same_thread (*this, boost::bind (&Session::route_solo_isolated_changed, this, wpr));
 			r->mute_control()->Changed.connect_same_thread (*this, boost::bind (&Session::route_mute_changed, this));
 
-			r->processors_changed.connect_same_thread (*this, boost::bind (&Session::route_processors_changed, this, _1));
-			r->processor_latency_changed.connect_same_thread (*this, boost::bind (&Session::queue_latency_recompute, this));
+			r->processors_changed.connect_same_thread (*this, boost::bind (&Session::route_processors_changed, this, _1, wpr));
+			r->processor_latency_changed.connect_same_thread (*this, boost::bind (&Session::queue_route_latency_recompute, this, wpr));
 
 			if (r->is_master()) {
 				_master_out = r;
@@ -6614,6 +6669,18 @@ Session::plot_process_graph (std::string const& file_name) const {
 	return _graph_chain ? _graph_chain->plot (file_name) : false;
 }
 
+GraphWakeupStats
+Session::graph_wakeup_stats () const
+{
+	return _process_graph->wakeup_stats ();
+}
+
+void
+Session::reset_graph_wakeup_stats ()
+{
+	_process_graph->reset_wakeup_stats ();
+}
+
 void
 Session::add_automation_list(AutomationList *al)
 {
@@ -7089,7 +7156,7 @@ Session::update_send_delaylines ()
 }
 
 bool
-Session::update_route_latency (bool playback, bool apply_to_delayline, bool* delayline_update_needed)
+Session::update_route_latency (bool playback, bool apply_to_delayline, bool* delayline_update_needed, RouteList const* dirty)
 {
 	/* apply_to_delayline can no be called concurrently with processing
 	 * caller must hold process lock when apply_to_delayline == true */
@@ -7107,7 +7174,36 @@ Session::update_route_latency (bool playback, bool apply_to_delayline, bool* del
 		reverse (r.begin(), r.end());
 	}
 
+	if (dirty) {
+		/* Only the given routes and all routes fed by them need to be
+		 * re-computed. Filtering the list retains the process order.
+		 */
+		assert (!playback && !apply_to_delayline);
+		std::shared_ptr<GraphEdges const> edges = _route_graph_edges.reader ();
+		std::set<GraphVertex>             affected;
+		std::vector<GraphVertex>          queue (dirty->begin (), dirty->end ());
+		while (!queue.empty ()) {
+			GraphVertex v = queue.back ();
+			queue.pop_back ();
+			if (!affected.insert (v).second) {
+				continue;
+			}
+			for (auto const& n : edges->from (v)) {
+				queue.push_back (n);
+			}
+		}
+		for (RouteList::iterator i = r.begin (); i != r.end ();) {
+			if (affected.find (*i) == affected.end ()) {
+				i = r.erase (i);
+			} else {
+				++i;
+			}
+		}
+		DEBUG_TRACE (DEBUG::LatencyCompensation , string_compose ("update_route_latency: %1 of %2 routes affected\n", r.size (), routes.reader ()->size ()));
+	}
+
 	bool changed = false;
+	bool master_changed = false;
 	int bailout = 0;
 restart:
 	_send_latency_changes = 0;
@@ -7118,10 +7214,29 @@ restart:
 		samplecnt_t l;
 		if (i->signal_latency () != (l = i->update_signal_latency (apply_to_delayline, delayline_update_needed))) {
 			changed = true;
+			master_changed |= i->is_master ();
 		}
 		_worst_route_latency = std::max (l, _worst_route_latency);
 	}
 
+	if (dirty && (_send_latency_changes > 0 || master_changed)) {
+		/* Latent sends are aligned to their target, and routes with unconnected
+		 * outputs to the master-bus. Those are not necessarily fed by the
+		 * dirty routes, so update all routes.
+		 */
+		DEBUG_TRACE (DEBUG::LatencyCompensation, "update_route_latency: sends or master-bus changed, update all routes\n");
+		dirty = 0;
+		r = *routes.reader ();
+		goto restart;
+	}
+
+	if (dirty) {
+		/* worst-case also includes routes that were not updated */
+		for (auto const& i : *routes.reader ()) {
+			_worst_route_latency = std::max (i->signal_latency (), _worst_route_latency);
+		}
+	}
+
 	if (_send_latency_changes > 0) {
 		/* One extra iteration might be needed since we allow u level of aux-sends.
 		 * Except mixbus that allows up to 3 (aux-sends, sends to mixbusses 1-8, sends to mixbusses 9-12,
@@ -7349,7 +7464,7 @@ Session::set_worst_input_latency ()
 }
 
 void
-Session::update_latency_compensation (bool force_whole_graph, bool called_from_backend)
+Session::update_latency_compensation (bool force_whole_graph, bool called_from_backend, bool incremental)
 {
 	/* Called to update Ardour's internal latency values and compensation
 	 * planning. Typically case is from within ::graph_reordered()
@@ -7367,17 +7482,45 @@ Session::update_latency_compensation (bool force_whole_graph, bool called_from_b
 	 */
 	Glib::Threads::Mutex::Lock lx (_update_latency_lock, Glib::Threads::TRY_LOCK);
 	if (!lx.locked()) {
-		/* no need to do this twice */
+		/* no need to do this twice, unless the concurrent update
+		 * was incremental and does not include the dirty routes.
+		 */
+		if (incremental) {
+			_latency_recompute_pending.fetch_add (1);
+			auto_connect_thread_wakeup ();
+		}
+		return;
+	}
+
+	/* incremental updates only re-compute routes whose processors'
+	 * latency changed, and routes downstream of those.
+	 */
+	std::shared_ptr<RouteList> dirty;
+	if (incremental && !force_whole_graph) {
+		dirty = take_latency_dirty_routes ();
+	}
+
+	if (dirty && dirty->empty ()) {
+		DEBUG_TRACE (DEBUG::LatencyCompensation, "update_latency_compensation: no routes changed.\n");
 		return;
 	}
 
-	DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("update_latency_compensation%1.\n", (force_whole_graph ? " of whole graph" : "")));
+	DEBUG_TRACE (DEBUG::LatencyCompensation, string_compose ("update_latency_compensation%1.\n", (force_whole_graph ? " of whole graph" : dirty ? " of dirty routes" : "")));
 
 	bool delayline_update_needed = false;
-	bool some_track_latency_changed = update_route_latency (false, false, &delayline_update_needed);
+	bool some_track_latency_changed = update_route_latency (false, false, &delayline_update_needed, dirty.get ());
 
 	if (some_track_latency_changed || force_whole_graph)  {
 
+		/* The route's own latency changed, so the latency of its
+		 * ports does as well. This is propagated by the engine's
+		 * latency callback, which also informs other clients of the
+		 * backend. That is a full walk of all routes
+		 * (Session::update_latency), incremental updates only limit
+		 * the cost of the cases above and below, where only the
+		 * delaylines change.
+		 */
+
 		/* cannot hold lock while engine initiates a full latency callback */
 
 		lx.release ();
@@ -7685,10 +7828,55 @@ Session::auto_connect_thread_wakeup ()
 void
 Session::queue_latency_recompute ()
 {
+	{
+		Glib::Threads::Mutex::Lock lm (_latency_dirty_lock);
+		_latency_dirty_all = true;
+	}
 	_latency_recompute_pending.fetch_add (1);
 	auto_connect_thread_wakeup ();
 }
 
+void
+Session::queue_route_latency_recompute (std::weak_ptr<Route> wr)
+{
+	mark_route_latency_dirty (wr);
+	_latency_recompute_pending.fetch_add (1);
+	auto_connect_thread_wakeup ();
+}
+
+void
+Session::mark_route_latency_dirty (std::weak_ptr<Route> wr)
+{
+	Glib::Threads::Mutex::Lock lm (_latency_dirty_lock);
+	if (!_latency_dirty_all) {
+		_latency_dirty_routes.insert (wr);
+	}
+}
+
+/** @return routes that need to be updated, an empty list if
+ * nothing changed, or an empty pointer if all routes have to be updated.
+ */
+std::shared_ptr<RouteList>
+Session::take_latency_dirty_routes ()
+{
+	Glib::Threads::Mutex::Lock lm (_latency_dirty_lock);
+
+	std::shared_ptr<RouteList> rl;
+	if (!_latency_dirty_all) {
+		rl.reset (new RouteList);
+		for (auto const& wr : _latency_dirty_routes) {
+			std::shared_ptr<Route> r = wr.lock ();
+			if (r) {
+				rl->push_back (r);
+			}
+		}
+	}
+
+	_latency_dirty_all = false;
+	_latency_dirty_routes.clear ();
+	return rl;
+}
+
 void
 Session::auto_connect (const AutoConnectRequest& ar)
 {
@@ -7880,7 +8068,7 @@ Session::auto_connect_thread_run ()
 			 * modifies the capture-offset, which can be a problem.
 			 */
 			while (_latency_recompute_pending.fetch_and (0)) {
-				update_latency_compensation (false, false);
+				update_latency_compensation (false, false, true);
 				if (_latency_recompute_pending.load ()) {
 					Glib::usleep (1000);
 				}
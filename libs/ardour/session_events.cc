@@ -20,6 +20,7 @@
  */
 
 #include <cmath>
+#include <new>
 #include <unistd.h>
 
 #include "pbd/error.h"
@@ -37,43 +38,66 @@ using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
 
-PerThreadPool* SessionEvent::pool;
+MagazinePool* SessionEvent::pool;
 
 void
 SessionEvent::init_event_pool ()
 {
-	pool = new PerThreadPool;
+	pool = new MagazinePool ("SessionEvent", sizeof (SessionEvent), 1024);
 }
 
 guint
 SessionEvent::pool_available ()
 {
-	if (!pool || !pool->per_thread_pool (false)) {
+	if (!pool) {
 		return 0;
 	}
-	return pool->per_thread_pool()->available ();
+	/* only events in the shared depot or the calling thread's
+	 * cache can be allocated without growing the pool */
+	return pool->thread_available ();
 }
 
 bool
 SessionEvent::has_per_thread_pool ()
 {
-	return pool->has_per_thread_pool ();
+	return pool->has_thread_cache ();
 }
 
 void
 SessionEvent::create_per_thread_pool (const std::string& name, uint32_t nitems)
 {
-	/* this is a per-thread call that simply creates a thread-private ptr to
-	   a CrossThreadPool for use by this thread whenever events are allocated/released
-	   from SessionEvent::pool()
-	*/
-	pool->create_per_thread_pool (name, sizeof (SessionEvent), nitems,
-#ifndef NDEBUG
-			[](size_t i, void*p) { std::cout << i << " " << *static_cast<SessionEvent*> (p) << "\n"; }
-#else
-			NULL
-#endif
-			);
+	/* this is a per-thread call that sets up this thread's cache
+	 * of free events, and makes sure that at least @a nitems events
+	 * can be allocated without growing the pool (which is shared by
+	 * all threads).
+	 *
+	 * Threads that do not call this, still can allocate events, the cache
+	 * is then created on demand, which is not realtime safe.
+	 */
+	DEBUG_TRACE (DEBUG::SessionEvents, string_compose ("%1 creates SessionEvent cache, reserve %2\n", name, nitems));
+	pool->create_thread_cache ();
+	pool->reserve (nitems);
+}
+
+/** Grow the event pool if events were taken from the reserve.
+ * This is called periodically from the butler thread.
+ */
+void
+SessionEvent::refill_pool ()
+{
+	pool->refill ();
+}
+
+MagazinePool::Stats
+SessionEvent::pool_stats ()
+{
+	return pool->stats ();
+}
+
+void
+SessionEvent::reset_pool_stats ()
+{
+	pool->reset_stats ();
 }
 
 SessionEvent::SessionEvent (Type t, Action a, samplepos_t when, samplepos_t where, double spd, bool yn, bool yn2, bool yn3)
@@ -93,36 +117,26 @@ SessionEvent::SessionEvent (Type t, Action a, samplepos_t when, samplepos_t wher
 void *
 SessionEvent::operator new (size_t)
 {
-	CrossThreadPool* p = pool->per_thread_pool ();
-	SessionEvent* ev = static_cast<SessionEvent*> (p->alloc ());
-	DEBUG_TRACE (DEBUG::SessionEvents, string_compose ("%1 Allocating SessionEvent from %2 ev @ %3 pool size %4 free %5 used %6\n", pthread_name(), p->name(), ev,
-	                                                   p->total(), p->available(), p->used()));
-
-	ev->own_pool = p;
+	void* ev = pool->alloc ();
+	if (!ev) {
+		throw std::bad_alloc ();
+	}
+	DEBUG_TRACE (DEBUG::SessionEvents, string_compose ("%1 Allocating SessionEvent @ %2 pool size %3 free %4 used %5\n", pthread_name(), ev,
+	                                                   pool->total(), pool->available(), pool->used()));
 	return ev;
 }
 
 void
 SessionEvent::operator delete (void *ptr, size_t /*size*/)
 {
-	Pool* p = pool->per_thread_pool (false);
-	SessionEvent* ev = static_cast<SessionEvent*> (ptr);
-
 	DEBUG_TRACE (DEBUG::SessionEvents, string_compose (
-		             "%1 Deleting SessionEvent @ %2 type %3 action %4 ev thread pool = %5 ev pool = %6 size %7 free %8 used %9\n",
-		             pthread_name(), ev, enum_2_string (ev->type), enum_2_string (ev->action), p->name(), ev->own_pool->name(), ev->own_pool->total(), ev->own_pool->available(), ev->own_pool->used()
+		             "%1 Deleting SessionEvent @ %2 type %3 action %4 pool size %5 free %6 used %7\n",
+		             pthread_name(), ptr, enum_2_string (static_cast<SessionEvent*> (ptr)->type), enum_2_string (static_cast<SessionEvent*> (ptr)->action),
+		             pool->total(), pool->available(), pool->used()
 		             ));
 
-	if (p && p == ev->own_pool) {
-		p->release (ptr);
-	} else {
-		assert(ev->own_pool);
-		ev->own_pool->push (ev);
-		DEBUG_TRACE (DEBUG::SessionEvents, string_compose ("%1 was wrong thread for this pool, pushed event onto pending list, will be deleted on next alloc from %2 pool size %3 free %4 used %5 pending %6\n",
-		                                                   pthread_name(), ev->own_pool->name(),
-		                                                   ev->own_pool->total(), ev->own_pool->available(), ev->own_pool->used(),
-		                                                   ev->own_pool->pending_size()));
-	}
+	/* events can be released by any thread */
+	pool->release (ptr);
 }
 
 void
@@ -160,15 +174,7 @@ SessionEventManager::clear_events (SessionEvent::Type type, boost::function<void
 	SessionEvent* ev = new SessionEvent (type, SessionEvent::Clear, SessionEvent::Immediate, 0, 0);
 	ev->rt_slot = after;
 
-	/* in the calling thread, after the clear is complete, arrange to flush things from the event
-	   pool pending list (i.e. to make sure they are really back in the free list and available
-	   for future events).
-	*/
-
-	ev->event_loop = PBD::EventLoop::get_event_loop_for_thread ();
-	if (ev->event_loop) {
-		ev->rt_return = boost::bind (&CrossThreadPool::flush_pending_with_ev, ev->event_pool(), _1);
-	}
+	/* the event is deleted by the process thread, once the clear is complete */
 
 	queue_event (ev);
 }
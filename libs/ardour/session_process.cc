@@ -239,6 +239,8 @@ Session::no_roll (pframes_t nframes)
 		PT_TIMING_CHECK (11);
 	}
 
+	capture_pipelined_routes (nframes);
+
 	PT_TIMING_CHECK (5);
 	return ret;
 }
@@ -298,9 +300,31 @@ Session::process_routes (pframes_t nframes, bool& need_butler)
 		}
 	}
 
+	capture_pipelined_routes (nframes);
+
 	return 0;
 }
 
+/** Pipelined routes process the input of the previous cycle.
+ * Once all routes have been processed, their input ports and
+ * internal sends hold the data to be used in the next cycle.
+ *
+ * This is not done by the graph nodes: a pipelined node has no
+ * activation edges, and may run before or concurrently with the
+ * routes that feed it. Capturing when its feeds complete would
+ * race with the node reading the FIFO. Here, after the graph
+ * completed, no node is running, and the PipelineDelay does not
+ * need any synchronization.
+ */
+void
+Session::capture_pipelined_routes (pframes_t nframes)
+{
+	std::shared_ptr<RouteList const> r = routes.reader ();
+	for (auto const& i : *r) {
+		i->pipeline_capture (nframes);
+	}
+}
+
 void
 Session::get_track_statistics ()
 {
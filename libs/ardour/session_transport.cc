@@ -1901,7 +1901,7 @@ Session::reset_xrun_count ()
 }
 
 void
-Session::route_processors_changed (RouteProcessorChange c)
+Session::route_processors_changed (RouteProcessorChange c, std::weak_ptr<Route> wr)
 {
 	if (_ignore_route_processor_changes.load () > 0) {
 		(void) _ignored_a_processor_change.fetch_or (c.type);
@@ -1920,10 +1920,15 @@ Session::route_processors_changed (RouteProcessorChange c)
 		return;
 	}
 
-	resort_routes ();
+	/* only the route's sends, returns and inserts may have changed */
+	resort_routes (wr);
 
 	if (c.type == RouteProcessorChange::SendReturnChange) {
 		update_latency_compensation (true, false);
+	} else if (!wr.expired ()) {
+		/* only the given route and routes fed by it are affected */
+		mark_route_latency_dirty (wr);
+		update_latency_compensation (false, false, true);
 	} else {
 		update_latency_compensation (false, false);
 	}
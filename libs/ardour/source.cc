@@ -365,6 +365,12 @@ Source::load_transients (const string& path)
 
 string
 Source::get_transients_path () const
+{
+	return get_analysis_path (TransientDetector::operational_identifier());
+}
+
+string
+Source::get_analysis_path (string const& key) const
 {
 	vector<string> parts;
 	string s;
@@ -374,7 +380,7 @@ Source::get_transients_path () const
 
 	s = id().to_s();
 	s += '.';
-	s += TransientDetector::operational_identifier();
+	s += key;
 	parts.push_back (s);
 
 	return Glib::build_filename (parts);
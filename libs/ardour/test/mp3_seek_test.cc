@@ -0,0 +1,55 @@
+#include <cstdlib>
+#include <vector>
+
+#include "test_util.h"
+
+#include "pbd/file_utils.h"
+#include "ardour/mp3fileimportable.h"
+#include "mp3_seek_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (Mp3SeekTest);
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+void
+Mp3SeekTest::seekTest ()
+{
+	std::string test_file_path;
+	const string test_filename = "test.mp3";
+
+	CPPUNIT_ASSERT (find_file (test_search_path (), test_filename, test_file_path));
+
+	/* test.mp3 is a 32 kbit/s mono file, whose frames reference
+	 * up to 300 bytes of previous frames' data (bit-reservoir).
+	 * Seeking has to restore the reservoir, and must not skip
+	 * frames that cannot be decoded without it.
+	 */
+	Mp3FileImportableSource ref (test_file_path);
+	Mp3FileImportableSource s (test_file_path);
+
+	const samplecnt_t len = ref.length ();
+	CPPUNIT_ASSERT (len > 8192);
+
+	vector<Sample> A (len);
+	CPPUNIT_ASSERT_EQUAL (len, ref.read_unlocked (&A[0], 0, len, 0));
+
+	srand (1);
+	for (int i = 0; i < 1000; ++i) {
+		samplepos_t pos;
+		if (i % 3) {
+			pos = rand () % (len - 256);
+		} else {
+			/* at, or next to a frame boundary */
+			pos = (rand () % (len / 1152 - 1)) * 1152 + (i % 2);
+		}
+
+		Sample B[256];
+		CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 256, s.read_unlocked (B, pos, 256, 0));
+
+		for (int n = 0; n < 256; ++n) {
+			CPPUNIT_ASSERT_EQUAL (A[pos + n], B[n]);
+		}
+	}
+}
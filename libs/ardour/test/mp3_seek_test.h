@@ -0,0 +1,12 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class Mp3SeekTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (Mp3SeekTest);
+	CPPUNIT_TEST (seekTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void seekTest ();
+};
@@ -0,0 +1,45 @@
+#include "ardour/audioengine.h"
+#include "ardour/audio_track.h"
+#include "ardour/route.h"
+#include "ardour/session.h"
+
+#include "pipelined_route_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PipelinedRouteTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/** A pipelined bus processes the input of the previous cycle, and must
+ * report one additional period of latency.
+ */
+void
+PipelinedRouteTest::latencyTest ()
+{
+	RouteList rl = _session->new_audio_route (2, 2, 0, 1, "Bus", PresentationInfo::AudioBus, PresentationInfo::max_order);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, rl.size ());
+
+	std::shared_ptr<Route> bus = rl.front ();
+	const samplecnt_t period   = AudioEngine::instance ()->samples_per_cycle ();
+	const samplecnt_t latency  = bus->update_signal_latency ();
+
+	CPPUNIT_ASSERT (!bus->pipelined ());
+	CPPUNIT_ASSERT (bus->set_pipelined (true));
+	CPPUNIT_ASSERT (bus->pipelined ());
+	CPPUNIT_ASSERT_EQUAL (latency + period, bus->update_signal_latency ());
+	CPPUNIT_ASSERT_EQUAL (latency + period, bus->signal_latency ());
+
+	CPPUNIT_ASSERT (bus->set_pipelined (false));
+	CPPUNIT_ASSERT_EQUAL (latency, bus->update_signal_latency ());
+}
+
+void
+PipelinedRouteTest::tracksTest ()
+{
+	list<std::shared_ptr<AudioTrack> > tl = _session->new_audio_track (1, 2, 0, 1, "Track", PresentationInfo::max_order);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, tl.size ());
+
+	std::shared_ptr<AudioTrack> track = tl.front ();
+	CPPUNIT_ASSERT (!track->set_pipelined (true));
+	CPPUNIT_ASSERT (!track->pipelined ());
+}
@@ -0,0 +1,13 @@
+#include "test_needing_session.h"
+
+class PipelinedRouteTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (PipelinedRouteTest);
+	CPPUNIT_TEST (latencyTest);
+	CPPUNIT_TEST (tracksTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void latencyTest ();
+	void tracksTest ();
+};
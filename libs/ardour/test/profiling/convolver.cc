@@ -0,0 +1,120 @@
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <time.h>
+
+#include "pbd/compose.h"
+
+#include "ardour/ardour.h"
+#include "ardour/audioengine.h"
+#include "ardour/convolver.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/readable.h"
+#include "ardour/session.h"
+
+#include "test_ui.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/** exponentially decaying noise */
+class SyntheticIR : public AudioReadable
+{
+public:
+	SyntheticIR (samplecnt_t len)
+		: _len (len)
+	{
+		srand (len);
+	}
+
+	samplecnt_t read (Sample* buf, samplepos_t pos, samplecnt_t cnt, int channel) const
+	{
+		cnt = std::min (cnt, _len - pos);
+		for (samplecnt_t i = 0; i < cnt; ++i) {
+			buf[i] = expf (-6.9f * (pos + i) / _len) * (rand () / (float)RAND_MAX - .5f);
+		}
+		return std::max<samplecnt_t> (0, cnt);
+	}
+
+	samplecnt_t readable_length_samples () const { return _len; }
+	uint32_t    n_channels () const { return 1; }
+
+private:
+	samplecnt_t _len;
+};
+
+static double
+cpu_time ()
+{
+	struct timespec ts;
+	clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double
+run (Session* session, std::shared_ptr<AudioReadable> ir, uint32_t n_instances, uint32_t n_cycles, bool pool)
+{
+	Config->set_convolver_thread_pool (pool);
+
+	pframes_t const n_samples = session->engine ().samples_per_cycle ();
+
+	std::vector<Convolution*> conv;
+	for (uint32_t i = 0; i < n_instances; ++i) {
+		Convolution* c = new Convolution (*session, 1, 1);
+		c->add_impdata (0, 0, ir);
+		c->set_partitioning (0, 8192);
+		c->restart ();
+		conv.push_back (c);
+	}
+
+	std::vector<float> buf (n_samples);
+
+	double t0 = cpu_time ();
+	for (uint32_t n = 0; n < n_cycles; ++n) {
+		for (uint32_t i = 0; i < n_instances; ++i) {
+			for (pframes_t s = 0; s < n_samples; ++s) {
+				buf[s] = (rand () / (float)RAND_MAX - .5f);
+			}
+			conv[i]->run_mono_buffered (&buf[0], n_samples);
+		}
+	}
+	double t1 = cpu_time ();
+
+	for (std::vector<Convolution*>::iterator i = conv.begin (); i != conv.end (); ++i) {
+		delete *i;
+	}
+
+	/* CPU time per channel, relative to realtime */
+	double realtime = n_cycles * n_samples / (double)session->nominal_sample_rate ();
+	return 100. * (t1 - t0) / realtime / n_instances;
+}
+
+int
+main (int argc, char* argv[])
+{
+	uint32_t n_instances = argc > 1 ? atoi (argv[1]) : 16;
+	double   ir_seconds  = argc > 2 ? atof (argv[2]) : 4.0;
+	uint32_t n_cycles    = 4096;
+
+	ARDOUR::init (true, localedir);
+	TestUI* test_ui = new TestUI();
+	create_and_start_dummy_backend ();
+
+	Session* session = load_session ("../libs/ardour/test/profiling/sessions/1region", "1region");
+
+	std::shared_ptr<AudioReadable> ir (new SyntheticIR (ir_seconds * session->nominal_sample_rate ()));
+
+	cout << string_compose ("INFO: %1 channels, %2 sec IR, %3 samples per cycle\n", n_instances, ir_seconds, session->engine ().samples_per_cycle ());
+	cout << string_compose ("DSP per channel, thread per partition: %1 %%\n", run (session, ir, n_instances, n_cycles, false));
+	cout << string_compose ("DSP per channel, shared thread pool:   %1 %%\n", run (session, ir, n_instances, n_cycles, true));
+
+	delete session;
+	stop_and_destroy_backend ();
+	delete test_ui;
+	ARDOUR::cleanup ();
+	return 0;
+}
@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include "ardour/audioengine.h"
@@ -40,6 +41,8 @@ ThreadBuffers::ThreadBuffers ()
 	, scratch_automation_buffer (0)
 	, pan_automation_buffer (0)
 	, npan_buffers (0)
+	, numa_node (-1)
+	, _custom (0)
 {
 }
 
@@ -86,9 +89,57 @@ ThreadBuffers::ensure_buffers (ChanCount howmany, size_t custom)
 	delete[] scratch_automation_buffer;
 	scratch_automation_buffer = new gain_t[audio_buffer_size];
 
+	/* first-touch, see ::reallocate() */
+	memset (gain_automation_buffer, 0, sizeof (gain_t) * audio_buffer_size);
+	memset (trim_automation_buffer, 0, sizeof (gain_t) * audio_buffer_size);
+	memset (send_gain_automation_buffer, 0, sizeof (gain_t) * audio_buffer_size);
+	memset (scratch_automation_buffer, 0, sizeof (gain_t) * audio_buffer_size);
+
+	_custom = custom;
+
 	allocate_pan_automation_buffers (audio_buffer_size, howmany.n_audio (), false);
 }
 
+/** Free and re-allocate all buffers from the calling thread.
+ *
+ * With the default memory policy, pages are placed on the memory node of
+ * the thread that first touches them. This is used to place the buffers
+ * close to the thread that will use them. Must only be called while
+ * the buffers are not in use.
+ */
+void
+ThreadBuffers::reallocate ()
+{
+	ChanCount howmany = scratch_buffers->available ();
+
+	if (howmany == ChanCount::ZERO) {
+		/* not yet allocated */
+		return;
+	}
+
+	delete silent_buffers;
+	delete scratch_buffers;
+	delete noinplace_buffers;
+	delete route_buffers;
+	delete mix_buffers;
+
+	silent_buffers    = new BufferSet;
+	scratch_buffers   = new BufferSet;
+	noinplace_buffers = new BufferSet;
+	route_buffers     = new BufferSet;
+	mix_buffers       = new BufferSet;
+
+	for (uint32_t i = 0; i < npan_buffers; ++i) {
+		delete[] pan_automation_buffer[i];
+	}
+	delete[] pan_automation_buffer;
+	pan_automation_buffer = 0;
+	howmany.set_audio (std::max (howmany.n_audio (), npan_buffers));
+	npan_buffers = 0;
+
+	ensure_buffers (howmany, _custom);
+}
+
 void
 ThreadBuffers::allocate_pan_automation_buffers (samplecnt_t nframes, uint32_t howmany, bool force)
 {
@@ -112,6 +163,7 @@ ThreadBuffers::allocate_pan_automation_buffers (samplecnt_t nframes, uint32_t ho
 
 	for (uint32_t i = 0; i < howmany; ++i) {
 		pan_automation_buffer[i] = new pan_t[nframes];
+		memset (pan_automation_buffer[i], 0, sizeof (pan_t) * nframes);
 	}
 
 	npan_buffers = howmany;
@@ -1261,15 +1261,34 @@ AudioTrigger::AudioTrigger (uint32_t n, TriggerBox& b)
 	, got_stretcher_padding (false)
 	, to_pad (0)
 	, to_drop (0)
+	, _pending_stretch_cache (0)
+	, _stretch_cache (0)
+	, _prestretch_ratio (0)
+	, _prestretch_mode (Trigger::Crisp)
+	, _cache_use (CacheUndecided)
+	, _cache_index (0)
+	, _alive (new std::atomic<bool> (true))
 {
 }
 
 AudioTrigger::~AudioTrigger ()
 {
+	/* AudioTriggers are deleted by the TriggerBoxThread (see
+	 * Trigger::request_trigger_delete), so this cannot run concurrently
+	 * with ::prestretch(). Cancel requests that are still queued.
+	 */
+	_alive->store (false);
 	drop_data ();
 	delete _stretcher;
 }
 
+AudioTrigger::StretchCache::~StretchCache ()
+{
+	for (auto& d : data) {
+		delete [] d;
+	}
+}
+
 void
 AudioTrigger::set_stretch_mode (Trigger::StretchMode sm)
 {
@@ -1280,6 +1299,8 @@ AudioTrigger::set_stretch_mode (Trigger::StretchMode sm)
 	_stretch_mode = sm;
 	send_property_change (Properties::stretch_mode);
 	_box.session().set_dirty();
+
+	queue_prestretch ();
 }
 
 void
@@ -1313,6 +1334,8 @@ AudioTrigger::set_segment_tempo (double t)
 
 		send_property_change (ARDOUR::Properties::tempo_meter);
 		_box.session().set_dirty();
+
+		queue_prestretch ();
 	}
 
 	/* TODO:  once we have a Region Trimmer, this could get more complicated:
@@ -1607,6 +1630,9 @@ AudioTrigger::set_region_in_worker_thread (std::shared_ptr<Region> r)
 
 	send_property_change (ARDOUR::Properties::name);
 
+	/* we're in the worker thread, render the stretched data right away */
+	prestretch ();
+
 	return 0;
 }
 
@@ -1798,36 +1824,274 @@ AudioTrigger::setup_stretcher ()
 void
 AudioTrigger::drop_data ()
 {
-	for (auto& d : data) {
-		delete [] d;
-	}
 	data.clear ();
+
+	if (_clip_data) {
+		_clip_data.reset ();
+		AudioClipCache::trim ();
+	}
+
+	/* any stretched data is no longer valid.
+	 * Like data itself, this is only called when the trigger is not active.
+	 */
+	delete _pending_stretch_cache.exchange (0);
+	delete _stretch_cache;
+	_stretch_cache    = 0;
+	_prestretch_ratio = 0;
 }
 
-int
-AudioTrigger::load_data (std::shared_ptr<AudioRegion> ar)
+void
+AudioTrigger::queue_prestretch ()
 {
-	const uint32_t nchans = ar->n_channels();
+	if (_region && stretching () && TriggerBox::worker) {
+		TriggerBox::worker->request_prestretch (this, _alive);
+	}
+}
 
-	data.length = ar->length_samples();
-	drop_data ();
+void
+AudioTrigger::prestretch ()
+{
+	using namespace RubberBand;
+
+	if (!_region || data.empty () || data.length == 0 || _segment_tempo <= 1. || !stretching ()) {
+		return;
+	}
+
+	Temporal::TempoMap::SharedPtr tmap (Temporal::TempoMap::use());
+	const double bpm   = tmap->quarters_per_minute_at (timepos_t (_box.session().transport_sample ()));
+	const double ratio = _segment_tempo / bpm;
+	const StretchMode mode = _stretch_mode;
+
+	if (_prestretch_ratio == ratio && _prestretch_mode == mode) {
+		/* already rendered, or in progress */
+		return;
+	}
+
+	RubberBandStretcher::Option ro = RubberBandStretcher::Option (0);
+	switch (mode) {
+		case Trigger::Crisp  : ro = RubberBandStretcher::OptionTransientsCrisp; break;
+		case Trigger::Mixed  : ro = RubberBandStretcher::OptionTransientsMixed; break;
+		case Trigger::Smooth : ro = RubberBandStretcher::OptionTransientsSmooth; break;
+	}
+
+	const uint32_t    nchans    = data.size ();
+	const samplecnt_t out_len   = (samplecnt_t) llrint (data.length * ratio);
+	const samplecnt_t blocksize = 8192;
+
+	StretchCache* sc = new StretchCache (ratio, mode);
 
 	try {
-		for (uint32_t n = 0; n < nchans; ++n) {
-			data.push_back (new Sample[data.length]);
-			ar->read (data[n], 0, data.length, n);
+		/* offline mode: no start delay, and more accurate than realtime mode */
+		RubberBandStretcher stretcher (_box.session().sample_rate(), nchans, RubberBandStretcher::Options (ro), ratio, 1.0);
+		stretcher.setMaxProcessSize (blocksize);
+
+		for (uint32_t chn = 0; chn < nchans; ++chn) {
+			sc->data.push_back (new Sample[out_len]);
 		}
 
-		set_name (ar->name());
+		std::vector<Sample*> in (nchans);
+		std::vector<Sample*> out (nchans);
+
+		for (samplecnt_t pos = 0; pos < data.length; pos += blocksize) {
+			const samplecnt_t n = std::min (blocksize, data.length - pos);
+			for (uint32_t chn = 0; chn < nchans; ++chn) {
+				in[chn] = data[chn] + pos;
+			}
+			stretcher.study (&in[0], n, pos + n >= data.length);
+		}
+
+		samplecnt_t pos = 0;
+		int avail;
+
+		while (pos < data.length) {
+			const samplecnt_t n = std::min (blocksize, data.length - pos);
+			for (uint32_t chn = 0; chn < nchans; ++chn) {
+				in[chn] = data[chn] + pos;
+			}
+			pos += n;
+			stretcher.process (&in[0], n, pos >= data.length);
+
+			while ((avail = stretcher.available ()) > 0 && sc->length < out_len) {
+				for (uint32_t chn = 0; chn < nchans; ++chn) {
+					out[chn] = sc->data[chn] + sc->length;
+				}
+				sc->length += stretcher.retrieve (&out[0], std::min<samplecnt_t> (avail, out_len - sc->length));
+			}
+		}
+
+		while ((avail = stretcher.available ()) >= 0 && sc->length < out_len) {
+			if (avail == 0) {
+				/* wait for stretcher threads */
+				Glib::usleep (1000);
+				continue;
+			}
+			for (uint32_t chn = 0; chn < nchans; ++chn) {
+				out[chn] = sc->data[chn] + sc->length;
+			}
+			sc->length += stretcher.retrieve (&out[0], std::min<samplecnt_t> (avail, out_len - sc->length));
+		}
 
 	} catch (...) {
-		drop_data ();
+		delete sc;
+		return;
+	}
+
+	/* the stretcher's output may be a few samples short */
+	for (uint32_t chn = 0; chn < nchans; ++chn) {
+		std::fill (sc->data[chn] + sc->length, sc->data[chn] + out_len, 0.f);
+	}
+	sc->length = out_len;
+
+	_prestretch_ratio = ratio;
+	_prestretch_mode  = mode;
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 pre-stretched %2 samples at ratio %3 to %4\n", index(), data.length, ratio, out_len));
+
+	/* if a previous cache was not yet picked up, it is no longer needed */
+	delete _pending_stretch_cache.exchange (sc);
+}
+
+int
+AudioTrigger::load_data (std::shared_ptr<AudioRegion> ar)
+{
+	drop_data ();
+
+	try {
+		_clip_data = AudioClipCache::get (ar);
+	} catch (...) {
+		data.length = 0;
 		return -1;
 	}
 
+	data.assign (_clip_data->begin (), _clip_data->end ());
+	data.length = _clip_data->length;
+
+	set_name (ar->name());
+
 	return 0;
 }
 
+/* ****** */
+
+Glib::Threads::Mutex  AudioClipCache::_lock;
+AudioClipCache::Cache AudioClipCache::_cache;
+uint64_t              AudioClipCache::_use_counter = 0;
+
+AudioClipCache::Data::~Data ()
+{
+	for (auto& d : *this) {
+		delete [] d;
+	}
+}
+
+bool
+AudioClipCache::Key::operator< (Key const & other) const
+{
+	if (start != other.start) {
+		return start < other.start;
+	}
+	if (length != other.length) {
+		return length < other.length;
+	}
+	return sources < other.sources;
+}
+
+AudioClipCache::DataPtr
+AudioClipCache::get (std::shared_ptr<AudioRegion> ar)
+{
+	const uint32_t nchans = ar->n_channels();
+
+	Key key;
+	key.start  = ar->start_sample ();
+	key.length = ar->length_samples ();
+
+	for (uint32_t n = 0; n < nchans; ++n) {
+		key.sources.push_back (ar->source (n)->id ());
+	}
+
+	/* hold the lock while reading, so that the same data is never read twice */
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Cache::iterator i = _cache.find (key);
+
+	if (i != _cache.end ()) {
+		DEBUG_TRACE (DEBUG::Triggers, string_compose ("clip cache hit for %1 (used by %2)\n", ar->name (), i->second.data.use_count () - 1));
+		i->second.last_use = ++_use_counter;
+		return i->second.data;
+	}
+
+	std::shared_ptr<Data> d (new Data);
+	d->length = key.length;
+
+	/* throws on allocation failure; d cleans up */
+	for (uint32_t n = 0; n < nchans; ++n) {
+		d->push_back (new Sample[d->length]);
+		ar->read (d->back (), 0, d->length, n);
+	}
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("clip cache read %1 samples x %2 for %3\n", d->length, nchans, ar->name ()));
+
+	Entry e;
+	e.data     = d;
+	e.last_use = ++_use_counter;
+	_cache.insert (std::make_pair (key, e));
+
+	trim_locked ();
+
+	return d;
+}
+
+void
+AudioClipCache::trim ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	trim_locked ();
+}
+
+void
+AudioClipCache::clear ()
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	for (Cache::iterator i = _cache.begin (); i != _cache.end ();) {
+		if (i->second.data.use_count () == 1) {
+			i = _cache.erase (i);
+		} else {
+			++i;
+		}
+	}
+}
+
+void
+AudioClipCache::trim_locked ()
+{
+	const size_t limit = (size_t) Config->get_clip_cache_size_mb () * 1048576;
+
+	/* data that is not used by any trigger, least recently used first */
+	std::vector<std::pair<uint64_t, Cache::iterator> > unused;
+	size_t unused_bytes = 0;
+
+	for (Cache::iterator i = _cache.begin (); i != _cache.end (); ++i) {
+		if (i->second.data.use_count () == 1) {
+			unused.push_back (std::make_pair (i->second.last_use, i));
+			unused_bytes += i->second.data->bytes ();
+		}
+	}
+
+	if (unused_bytes <= limit) {
+		return;
+	}
+
+	std::sort (unused.begin (), unused.end (), [] (std::pair<uint64_t, Cache::iterator> const & a, std::pair<uint64_t, Cache::iterator> const & b) { return a.first < b.first; });
+
+	for (auto & u : unused) {
+		if (unused_bytes <= limit) {
+			break;
+		}
+		unused_bytes -= u.second->second.data->bytes ();
+		_cache.erase (u.second);
+	}
+}
+
 void
 AudioTrigger::retrigger ()
 {
@@ -1836,9 +2100,20 @@ AudioTrigger::retrigger ()
 	update_properties ();
 	reset_stretcher ();
 
+	/* pick up newly rendered stretched data */
+	StretchCache* sc = _pending_stretch_cache.exchange (0);
+	if (sc) {
+		if (_stretch_cache) {
+			TriggerBox::worker->request_delete_stretch_cache (_stretch_cache);
+		}
+		_stretch_cache = sc;
+	}
+
 	read_index = _start_offset + _legato_offset;
 	retrieved = 0;
 	_legato_offset = 0; /* used one time only */
+	_cache_use = CacheUndecided;
+	_cache_index = 0;
 
 	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 retriggered to %2\n", _index, read_index));
 }
@@ -1857,6 +2132,9 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 	std::unique_ptr<BufferSet> scratchp;
 	std::vector<Sample*> bufp(nchans);
 	const bool do_stretch = stretching() && _segment_tempo > 1;
+	bool use_cache = false;
+	bool prime_stretcher = false;
+	samplecnt_t cache_end = 0;
 
 	quantize_offset = 0;
 
@@ -1903,9 +2181,40 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		bufp[chn] = scratch->get_audio (chn).data();
 	}
 
+	/* Use pre-stretched data while the tempo matches. If the tempo
+	 * changes (ramps), continue with the realtime stretcher from the
+	 * corresponding position.
+	 */
+
+	if (do_stretch && !_playout && _cache_use != CacheUnused) {
+
+		const double stretch = _segment_tempo / bpm;
+
+		if (_stretch_cache && _stretch_cache->matches (stretch, _stretch_mode) && _stretch_cache->data.size () == data.size ()) {
+			if (_cache_use == CacheUndecided) {
+				_cache_index = (samplecnt_t) llrint (read_index * stretch);
+				_cache_use = CacheUsed;
+			}
+			use_cache = true;
+			cache_end = std::min (_stretch_cache->length, (samplecnt_t) llrint (last_readable_sample * stretch));
+		} else {
+			if (_cache_use == CacheUsed) {
+				read_index = std::min (last_readable_sample, (samplecnt_t) llrint (_cache_index / _stretch_cache->ratio));
+				DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 tempo changed, continue realtime stretch at %2\n", index(), read_index));
+				/* the stretcher has to be padded again, use the
+				 * data preceding read_index instead of silence, so
+				 * that its output continues where the cache ended.
+				 */
+				reset_stretcher ();
+				prime_stretcher = true;
+			}
+			_cache_use = CacheUnused;
+		}
+	}
+
 	/* tell the stretcher what we are doing for this ::run() call */
 
-	if (do_stretch && !_playout) {
+	if (do_stretch && !use_cache && !_playout) {
 
 		const double stretch = _segment_tempo / bpm;
 		_stretcher->setTimeRatio (stretch);
@@ -1947,8 +2256,13 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 		while (to_pad > 0) {
 			const samplecnt_t limit = std::min ((samplecnt_t) scratch->get_audio (0).capacity(), to_pad);
+			/* when priming, pad with data (if any) up to read_index */
+			const samplecnt_t silent = prime_stretcher ? std::min (limit, std::max<samplecnt_t> (0, to_pad - read_index)) : limit;
 			for (uint32_t chn = 0; chn < nchans; ++chn) {
-				memset (bufp[chn], 0, sizeof (Sample) * limit);
+				memset (bufp[chn], 0, sizeof (Sample) * silent);
+				if (silent < limit) {
+					memcpy (bufp[chn] + silent, data[chn] + read_index - to_pad + silent, sizeof (Sample) * (limit - silent));
+				}
 			}
 
 			_stretcher->process (&bufp[0], limit, false);
@@ -1962,7 +2276,13 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		pframes_t to_stretcher;
 		pframes_t from_stretcher;
 
-		if (do_stretch) {
+		if (use_cache) {
+
+			from_stretcher = (pframes_t) std::min<samplecnt_t> (nframes, std::max<samplecnt_t> (0, cache_end - _cache_index));
+			/* like the realtime stretcher, do not exceed the expected duration */
+			from_stretcher = (pframes_t) std::min<samplecnt_t> (from_stretcher, std::max<samplecnt_t> (0, final_processed_sample - process_index));
+
+		} else if (do_stretch) {
 
 			if (read_index < last_readable_sample) {
 
@@ -2071,7 +2391,13 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 				uint32_t channel = chn %  data.size();
 				AudioBuffer& buf (bufs.get_audio (chn));
-				Sample* src = do_stretch ? bufp[channel] : (data[channel] + read_index);
+				Sample* src;
+
+				if (use_cache) {
+					src = _stretch_cache->data[channel] + _cache_index;
+				} else {
+					src = do_stretch ? bufp[channel] : (data[channel] + read_index);
+				}
 
 				gain_t gain;
 
@@ -2096,7 +2422,10 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		 * stretcher
 		 */
 
-		if (!do_stretch) {
+		if (use_cache) {
+			_cache_index += from_stretcher;
+			retrieved += from_stretcher;
+		} else if (!do_stretch) {
 			read_index += from_stretcher;
 		}
 
@@ -2104,7 +2433,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		avail = _stretcher->available ();
 		dest_offset += from_stretcher;
 
-		if (read_index >= last_readable_sample && (!do_stretch || avail <= 0)) {
+		if (use_cache ? (_cache_index >= cache_end || process_index >= final_processed_sample) : (read_index >= last_readable_sample && (!do_stretch || avail <= 0))) {
 
 			if (process_index < final_processed_sample) {
 				DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 reached end, entering playout mode to cover %2 .. %3\n", index(), process_index, final_processed_sample));
@@ -3112,6 +3441,7 @@ TriggerBox::TriggerBox (Session& s, DataType dt)
 	, _locate_armed (false)
 	, _cancel_locate_armed (false)
 	, _fast_forwarding (false)
+	, _retempo (new TriggerBoxThread::RetempoToken)
 	, requests (1024)
 {
 	set_display_to_user (false);
@@ -3120,7 +3450,10 @@ TriggerBox::TriggerBox (Session& s, DataType dt)
 
 	if (_data_type == DataType::AUDIO) {
 		for (uint32_t n = 0; n < TriggerBox::default_triggers_per_box; ++n) {
-			all_triggers.push_back (std::make_shared<AudioTrigger> (n, *this));
+			/* AudioTriggers queue work for the TriggerBoxThread, and
+			 * have to be deleted there as well
+			 */
+			all_triggers.push_back (TriggerPtr (new AudioTrigger (n, *this), Trigger::request_trigger_delete));
 		}
 	} else {
 		for (uint32_t n = 0; n < TriggerBox::default_triggers_per_box; ++n) {
@@ -3684,6 +4017,9 @@ TriggerBox::set_from_path (uint32_t slot, std::string const & path)
 
 TriggerBox::~TriggerBox ()
 {
+	/* cancel a queued re-tempo, or wait for it to complete */
+	Glib::Threads::Mutex::Lock lm (_retempo->lock);
+	_retempo->alive = false;
 }
 
 void
@@ -4827,6 +5163,40 @@ TriggerBox::tempo_map_changed ()
 	if (_currently_playing) {
 		_currently_playing->tempo_map_changed ();
 	}
+
+	/* re-render stretched data for the new tempo. Queue a single
+	 * request for all triggers of this box, unless one is pending.
+	 */
+	if (_data_type != DataType::AUDIO || !worker || _retempo->queued.exchange (true)) {
+		return;
+	}
+
+	if (!worker->request_retempo (*this, _retempo)) {
+		_retempo->queued = false;
+	}
+}
+
+void
+TriggerBox::retempo ()
+{
+	std::vector<AudioTrigger*> triggers;
+
+	{
+		Glib::Threads::RWLock::ReaderLock lm (trigger_lock);
+		for (auto const & t : all_triggers) {
+			AudioTrigger* at = dynamic_cast<AudioTrigger*> (t.get ());
+			if (at) {
+				triggers.push_back (at);
+			}
+		}
+	}
+
+	/* triggers are deleted by the TriggerBoxThread, so they
+	 * remain valid while this runs.
+	 */
+	for (auto const & at : triggers) {
+		at->prestretch ();
+	}
 }
 
 void
@@ -4896,6 +5266,24 @@ TriggerBoxThread::thread_work ()
 				case DeleteTrigger:
 					delete_trigger (req->trigger);
 					break;
+				case PreStretch:
+					if (req->audio_trigger_alive->load ()) {
+						req->audio_trigger->prestretch ();
+					}
+					break;
+				case DeleteStretchCache:
+					delete req->stretch_cache;
+					break;
+				case Retempo:
+					/* later tempo changes need a new request */
+					req->retempo->queued = false;
+					{
+						Glib::Threads::Mutex::Lock lm (req->retempo->lock);
+						if (req->retempo->alive) {
+							req->box->retempo ();
+						}
+					}
+					break;
 				default:
 					break;
 				}
@@ -4907,7 +5295,18 @@ TriggerBoxThread::thread_work ()
 	return (void *) 0;
 }
 
-void
+/** @return true if there is space for another request, in the pool and
+ * in the FIFO. The request pool aborts when it is exhausted, so optional
+ * requests (that may be queued in large numbers) should check this first.
+ * A few items are kept for other threads that may allocate concurrently.
+ */
+bool
+TriggerBoxThread::can_queue_request () const
+{
+	return Request::pool->available () > 8 && requests.write_space () > 8;
+}
+
+bool
 TriggerBoxThread::queue_request (Request* req)
 {
 	char c = req->type;
@@ -4918,11 +5317,13 @@ TriggerBoxThread::queue_request (Request* req)
 
 	if (req->type != Quit) {
 		if (requests.write (&req, 1) != 1) {
-			return;
+			delete req; /* back to pool */
+			return false;
 		}
 	}
 
 	_xthread.deliver (c);
+	return true;
 }
 
 void*
@@ -4963,6 +5364,38 @@ TriggerBoxThread::request_delete_trigger (Trigger* t)
 	queue_request (req);
 }
 
+bool
+TriggerBoxThread::request_prestretch (AudioTrigger* t, std::shared_ptr<std::atomic<bool> > alive)
+{
+	if (!can_queue_request ()) {
+		return false;
+	}
+	TriggerBoxThread::Request* req = new TriggerBoxThread::Request (PreStretch);
+	req->audio_trigger = t;
+	req->audio_trigger_alive = alive;
+	return queue_request (req);
+}
+
+bool
+TriggerBoxThread::request_retempo (TriggerBox& box, std::shared_ptr<RetempoToken> token)
+{
+	if (!can_queue_request ()) {
+		return false;
+	}
+	TriggerBoxThread::Request* req = new TriggerBoxThread::Request (Retempo);
+	req->box = &box;
+	req->retempo = token;
+	return queue_request (req);
+}
+
+void
+TriggerBoxThread::request_delete_stretch_cache (AudioTrigger::StretchCache* sc)
+{
+	TriggerBoxThread::Request* req = new TriggerBoxThread::Request (DeleteStretchCache);
+	req->stretch_cache = sc;
+	queue_request (req);
+}
+
 void
 TriggerBoxThread::delete_trigger (Trigger* t)
 {
@@ -606,7 +606,25 @@ ARDOUR::vst2_valid_cache_file (std::string const& path, bool verbose, bool* is_n
 		if (sb_vst.st_mtime < sb_v2i.st_mtime) {
 			/* plugin is older than cache file */
 			if (verbose) {
-				PBD::info << "Cache file is up-to-date." << endmsg;
+				PBD::info << "Cache file timestamp is valid." << endmsg;
+			}
+			/* check file format version */
+			XMLTree tree;
+			if (!tree.read (cache_file)) {
+				if (verbose) {
+					PBD::info << "Cache file is not valid XML." << endmsg;
+				}
+				return "";
+			}
+			int cf_version = 0;
+			if (!tree.root()->get_property ("version", cf_version) || cf_version < ARDOUR_VST2_CACHE_FILE_VERSION) {
+				if (verbose) {
+					PBD::info << "Cache file version is too old." << endmsg;
+				}
+				return "";
+			}
+			if (verbose) {
+				PBD::info << "Cache file is valid and up-to-date." << endmsg;
 			}
 			return cache_file;
 		} else if  (verbose) {
@@ -668,7 +686,7 @@ bool
 ARDOUR::vst2_scan_and_cache (std::string const& path, ARDOUR::PluginType type, boost::function<void (std::string const&, PluginType, VST2Info const&)> cb, bool verbose)
 {
 	XMLNode* root = new XMLNode ("VST2Cache");
-	root->set_property ("version", 1);
+	root->set_property ("version", ARDOUR_VST2_CACHE_FILE_VERSION);
 	root->set_property ("binary", path);
 	root->set_property ("arch", vst2_arch ());
 
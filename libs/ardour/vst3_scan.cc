@@ -47,8 +47,6 @@
 using namespace std;
 using namespace Steinberg;
 
-#define ARDOUR_VST3_CACHE_FILE_VERSION 2
-
 static const char* fmt_media (Vst::MediaType m) {
 	switch (m) {
 		case Vst::kAudio: return "kAudio";
@@ -20,8 +20,13 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <vector>
+
+#include <glibmm/threads.h>
 #include <glibmm/timer.h>
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/compose.h"
 #include "pbd/pthread_utils.h"
@@ -30,31 +35,200 @@
 
 namespace ARDOUR {
 
+/** Threads shared by all threaded workers.
+ *
+ * The pool exists while there is at least one threaded worker.
+ */
+class WorkerPool
+{
+public:
+	static WorkerPool* acquire ();
+	static void release ();
+
+	void add (Worker*);
+	void remove (Worker*);
+
+	/* realtime safe */
+	void signal () { _sem.signal (); }
+
+private:
+	WorkerPool ();
+	~WorkerPool ();
+
+	void    run ();
+	Worker* claim ();
+
+	Glib::Threads::RWLock     _lock; /* protects _workers */
+	std::vector<Worker*>      _workers;
+	std::atomic<size_t>       _next;
+	PBD::Semaphore            _sem;
+	std::vector<PBD::Thread*> _threads;
+	std::atomic<bool>         _exit;
+
+	static Glib::Threads::Mutex _instance_lock;
+	static WorkerPool*          _instance;
+	static uint32_t             _users;
+};
+
+Glib::Threads::Mutex WorkerPool::_instance_lock;
+WorkerPool*          WorkerPool::_instance = 0;
+uint32_t             WorkerPool::_users = 0;
+
+WorkerPool*
+WorkerPool::acquire ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	if (!_instance) {
+		_instance = new WorkerPool;
+	}
+	++_users;
+	return _instance;
+}
+
+void
+WorkerPool::release ()
+{
+	Glib::Threads::Mutex::Lock lm (_instance_lock);
+	assert (_users > 0);
+	if (--_users == 0) {
+		delete _instance;
+		_instance = 0;
+	}
+}
+
+WorkerPool::WorkerPool ()
+	: _next (0)
+	, _sem (string_compose ("worker_pool_semaphore%1", this).c_str(), 0)
+	, _exit (false)
+{
+	/* work is mostly file I/O (loading samples, IRs etc), a few threads
+	 * are sufficient regardless of the number of plugin instances.
+	 */
+	uint32_t n_threads = std::max<uint32_t> (2, std::min<uint32_t> (4, hardware_concurrency ()));
+
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		_threads.push_back (PBD::Thread::create (boost::bind (&WorkerPool::run, this)));
+	}
+}
+
+WorkerPool::~WorkerPool ()
+{
+	assert (_workers.empty ());
+
+	_exit = true;
+	for (size_t i = 0; i < _threads.size (); ++i) {
+		_sem.signal ();
+	}
+	for (auto& t : _threads) {
+		t->join ();
+		delete t;
+	}
+}
+
+void
+WorkerPool::add (Worker* w)
+{
+	Glib::Threads::RWLock::WriterLock lm (_lock);
+	_workers.push_back (w);
+}
+
+void
+WorkerPool::remove (Worker* w)
+{
+	{
+		Glib::Threads::RWLock::WriterLock lm (_lock);
+		std::vector<Worker*>::iterator i = std::find (_workers.begin (), _workers.end (), w);
+		if (i != _workers.end ()) {
+			_workers.erase (i);
+		}
+	}
+
+	/* workers are only claimed with the reader-lock held,
+	 * wait for a thread that may currently run work.
+	 */
+	while (w->_busy.load ()) {
+		Glib::usleep (1000);
+	}
+}
+
+Worker*
+WorkerPool::claim ()
+{
+	Glib::Threads::RWLock::ReaderLock lm (_lock);
+
+	size_t const n = _workers.size ();
+	size_t const s = _next.load ();
+
+	for (size_t i = 0; i < n; ++i) {
+		Worker* w = _workers[(s + i) % n];
+		if (w->_pending.load () == 0) {
+			continue;
+		}
+		bool idle = false;
+		if (w->_busy.compare_exchange_strong (idle, true)) {
+			/* continue with the next worker, next time */
+			_next = (s + i + 1) % n;
+			return w;
+		}
+	}
+	return 0;
+}
+
+void
+WorkerPool::run ()
+{
+	pthread_set_name ("LV2Worker");
+
+	while (true) {
+		_sem.wait ();
+		if (_exit) {
+			return;
+		}
+
+		/* A worker is processed by at most one thread at a time,
+		 * which retains the order of work for each worker.
+		 * Work that is scheduled while another thread processes
+		 * the worker is picked up by that thread, the worker is
+		 * re-claimed after it is released.
+		 */
+		Worker* w;
+		while ((w = claim ())) {
+			w->process_requests ();
+			w->_busy = false;
+		}
+	}
+}
+
+/* ****************************************************************************/
+
 Worker::Worker(Workee* workee, uint32_t ring_size, bool threaded)
 	: _workee(workee)
 	, _requests(threaded ? new PBD::RingBuffer<uint8_t>(ring_size) : NULL)
 	, _responses(new PBD::RingBuffer<uint8_t>(ring_size))
 	, _response((uint8_t*)malloc(ring_size))
-	, _sem(string_compose ("worker_semaphore%1", this).c_str(), 0)
-	, _thread(NULL)
-	, _exit(false)
+	, _work_buf(NULL)
+	, _work_buf_size(0)
+	, _pool(NULL)
+	, _pending(0)
+	, _busy(false)
 	, _synchronous(!threaded)
 {
 	if (threaded) {
-		_thread = PBD::Thread::create (boost::bind (&Worker::run, this));
+		_pool = WorkerPool::acquire ();
+		_pool->add (this);
 	}
 }
 
 Worker::~Worker()
 {
-	_exit = true;
-	_sem.signal();
-	if (_thread) {
-		_thread->join();
+	if (_pool) {
+		_pool->remove (this);
+		WorkerPool::release ();
 	}
 	delete _responses;
 	delete _requests;
 	free (_response);
+	free (_work_buf);
 }
 
 bool
@@ -74,7 +248,8 @@ Worker::schedule(uint32_t size, const void* data)
 	if (_requests->write((const uint8_t*)data, size) != size) {
 		return false;
 	}
-	_sem.signal();
+	_pending.fetch_add (1);
+	_pool->signal();
 	return true;
 }
 
@@ -135,55 +310,42 @@ Worker::emit_responses()
 }
 
 void
-Worker::run()
+Worker::process_requests()
 {
-	pthread_set_name ("LV2Worker");
+	while (_pending.load () > 0) {
+		uint32_t size;
 
-	void*  buf      = NULL;
-	size_t buf_size = 0;
-	while (true) {
-		_sem.wait();
-		if (_exit) {
-			free(buf);
-			return;
-		}
-
-		uint32_t size = _requests->read_space();
-		if (size < sizeof(size)) {
-			PBD::error << "Worker: no work-data on ring buffer" << endmsg;
-			continue;
-		}
 		while (!verify_message_completeness(_requests)) {
+			/* should not happen, messages are counted after they were written */
 			Glib::usleep(2000);
-			if (_exit) {
-				if (buf) free(buf);
-				return;
-			}
 		}
+
+		--_pending;
+
 		if (_requests->read((uint8_t*)&size, sizeof(size)) < sizeof(size)) {
 			PBD::error << "Worker: Error reading size from request ring"
 			           << endmsg;
 			continue;
 		}
 
-		if (size > buf_size) {
-			buf = realloc(buf, size);
-			if (buf) {
-				buf_size = size;
+		if (size > _work_buf_size) {
+			_work_buf = realloc(_work_buf, size);
+			if (_work_buf) {
+				_work_buf_size = size;
 			} else {
 				PBD::fatal << "Worker: Error allocating memory" << endmsg;
 				abort(); /*NOTREACHED*/
 			}
 		}
-		assert (buf);
+		assert (_work_buf);
 
-		if (_requests->read((uint8_t*)buf, size) < size) {
+		if (_requests->read((uint8_t*)_work_buf, size) < size) {
 			PBD::error << "Worker: Error reading body from request ring"
 			           << endmsg;
 			continue;  // TODO: This is probably fatal
 		}
 
-		_workee->work(*this, size, buf);
+		_workee->work(*this, size, _work_buf);
 	}
 }
 
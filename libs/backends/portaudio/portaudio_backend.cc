@@ -43,6 +43,7 @@
 
 #include "ardour/filesystem_paths.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 #include "pbd/i18n.h"
 
 #include "audio_utils.h"
@@ -1921,21 +1922,23 @@ PortAudioPort::~PortAudioPort () { }
 void* PortAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
-		if (it == get_connections ().end ()) {
+		std::shared_ptr<BackendPortList const> connections = rt_connections ();
+		BackendPortList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (connections->size () == 1) {
+			/* single connection: use the source's buffer directly (like JACK does) */
+			PortAudioPort* source = static_cast<PortAudioPort*> (it->get ());
+			assert (source && source->is_output ());
+			return source->buffer ();
 		} else {
-			std::shared_ptr<const PortAudioPort> source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
+			PortAudioPort* source = static_cast<PortAudioPort*> (it->get ());
 			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != get_connections ().end ()) {
-				source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
+			copy_vector (_buffer, source->const_buffer (), n_samples);
+			while (++it != connections->end ()) {
+				source = static_cast<PortAudioPort*> (it->get ());
 				assert (source && source->is_output ());
-				Sample* dst = buffer ();
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	}
@@ -32,6 +32,7 @@
 #include "pbd/pthread_utils.h"
 
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 
 #include "pulseaudio_backend.h"
 
@@ -1199,23 +1200,23 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
-
-		if (it == connections.end ()) {
+		std::shared_ptr<BackendPortList const> connections = rt_connections ();
+		BackendPortList::const_iterator it = connections->begin ();
+		if (it == connections->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
+		} else if (connections->size () == 1) {
+			/* single connection: use the source's buffer directly (like JACK does) */
+			PulseAudioPort* source = static_cast<PulseAudioPort*> (it->get ());
+			assert (source && source->is_output ());
+			return source->buffer ();
 		} else {
-			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
+			PulseAudioPort* source = static_cast<PulseAudioPort*> (it->get ());
 			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
+			copy_vector (_buffer, source->const_buffer (), n_samples);
+			while (++it != connections->end ()) {
+				source = static_cast<PulseAudioPort*> (it->get ());
 				assert (source && source->is_output ());
-				Sample*       dst = _buffer;
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	}
@@ -24,6 +24,11 @@
 #include <stdlib.h>
 
 #ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #elif defined(__APPLE__) || defined(__FreeBSD__)
 #include <stddef.h>
@@ -73,3 +78,156 @@ hardware_concurrency()
 	return 0;
 #endif
 }
+
+#ifdef __linux__
+
+/** parse a CPU list e.g. "0-3,8,10-11" */
+static std::vector<int>
+parse_cpu_list (const char* str)
+{
+	std::vector<int> rv;
+	while (str && *str) {
+		char* end;
+		long a = strtol (str, &end, 10);
+		if (end == str) {
+			break;
+		}
+		long b = a;
+		if (*end == '-') {
+			str = end + 1;
+			b = strtol (str, &end, 10);
+			if (end == str) {
+				break;
+			}
+		}
+		for (long i = a; i <= b; ++i) {
+			rv.push_back (i);
+		}
+		str = (*end == ',') ? end + 1 : 0;
+	}
+	return rv;
+}
+
+static bool
+read_sysfs (char const* path, char* buf, size_t len)
+{
+	FILE* f = fopen (path, "r");
+	if (!f) {
+		return false;
+	}
+	bool ok = fgets (buf, len, f) != 0;
+	fclose (f);
+	return ok;
+}
+
+static int
+read_sysfs_int (char const* path, int dflt)
+{
+	char buf[32];
+	if (!read_sysfs (path, buf, sizeof (buf))) {
+		return dflt;
+	}
+	return atoi (buf);
+}
+
+static std::vector<int>
+read_sysfs_cpu_list (char const* path)
+{
+	char buf[1024];
+	if (!read_sysfs (path, buf, sizeof (buf))) {
+		return std::vector<int> ();
+	}
+	return parse_cpu_list (buf);
+}
+
+#endif
+
+std::vector<PBD::CPUCore>
+PBD::cpu_topology ()
+{
+	std::vector<CPUCore> rv;
+#ifdef __linux__
+	char path[256];
+
+	std::vector<int> online = read_sysfs_cpu_list ("/sys/devices/system/cpu/online");
+
+	for (std::vector<int>::const_iterator i = online.begin (); i != online.end (); ++i) {
+		CPUCore c;
+		c.cpu = *i;
+
+		snprintf (path, sizeof (path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", c.cpu);
+		std::vector<int> siblings = read_sysfs_cpu_list (path);
+		if (siblings.empty ()) {
+			/* no topology information */
+			return std::vector<CPUCore> ();
+		}
+		c.core        = siblings.front ();
+		c.smt_sibling = siblings.front () != c.cpu;
+
+		/* the last level cache is identified by its first CPU */
+		c.l3 = c.core;
+		for (int n = 0; ; ++n) {
+			snprintf (path, sizeof (path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", c.cpu, n);
+			int level = read_sysfs_int (path, -1);
+			if (level < 0) {
+				break;
+			}
+			if (level < 3) {
+				continue;
+			}
+			snprintf (path, sizeof (path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", c.cpu, n);
+			std::vector<int> shared = read_sysfs_cpu_list (path);
+			if (!shared.empty ()) {
+				c.l3 = shared.front ();
+			}
+			break;
+		}
+
+		snprintf (path, sizeof (path), "/sys/devices/system/cpu/cpu%d", c.cpu);
+		DIR* dir = opendir (path);
+		if (dir) {
+			struct dirent* e;
+			while ((e = readdir (dir))) {
+				if (strncmp (e->d_name, "node", 4) == 0 && e->d_name[4] >= '0' && e->d_name[4] <= '9') {
+					c.numa_node = atoi (&e->d_name[4]);
+					break;
+				}
+			}
+			closedir (dir);
+		}
+
+		rv.push_back (c);
+	}
+#endif
+	return rv;
+}
+
+int
+PBD::current_cpu ()
+{
+#ifdef __linux__
+	return sched_getcpu ();
+#else
+	return -1;
+#endif
+}
+
+int
+PBD::set_thread_cpu_affinity (pthread_t thread, std::vector<int> const& cpus)
+{
+#ifdef __linux__
+	cpu_set_t set;
+	CPU_ZERO (&set);
+	for (std::vector<int>::const_iterator i = cpus.begin (); i != cpus.end (); ++i) {
+		if (*i >= 0 && *i < CPU_SETSIZE) {
+			CPU_SET (*i, &set);
+		}
+	}
+	if (CPU_COUNT (&set) == 0) {
+		return -1;
+	}
+	return pthread_setaffinity_np (thread, sizeof (cpu_set_t), &set);
+#else
+	return -1;
+#endif
+}
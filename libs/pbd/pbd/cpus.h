@@ -19,10 +19,38 @@
 #ifndef __libpbd_cpus_h__
 #define __libpbd_cpus_h__
 
+#include <pthread.h>
 #include <stdint.h>
+#include <vector>
 
 #include "pbd/libpbd_visibility.h"
 
 LIBPBD_API extern uint32_t hardware_concurrency ();
 
+namespace PBD {
+
+/** A logical CPU, as described by /sys/devices/system/cpu */
+struct LIBPBD_API CPUCore {
+	CPUCore () : cpu (-1), core (-1), l3 (-1), numa_node (0), smt_sibling (false) {}
+
+	int  cpu;         ///< logical CPU number
+	int  core;        ///< physical core, shared by SMT siblings
+	int  l3;          ///< last level cache, shared by CPUs with the same value
+	int  numa_node;   ///< NUMA memory node
+	bool smt_sibling; ///< true for all but the first hardware thread of a core
+};
+
+/** @return online CPUs and their topology, empty if unknown (only Linux is supported) */
+LIBPBD_API extern std::vector<CPUCore> cpu_topology ();
+
+/** @return the CPU that the calling thread runs on, or -1 if unknown */
+LIBPBD_API extern int current_cpu ();
+
+/** Restrict the given thread to the given CPUs.
+ * @return 0 on success
+ */
+LIBPBD_API extern int set_thread_cpu_affinity (pthread_t thread, std::vector<int> const& cpus);
+
+}
+
 #endif /* __libpbd_cpus_h__ */
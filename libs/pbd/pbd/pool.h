@@ -22,6 +22,8 @@
 #ifndef __qm_pool_h__
 #define __qm_pool_h__
 
+#include <atomic>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -173,6 +175,138 @@ private:
 	PBD::RingBuffer<CrossThreadPool*>* _trash;
 };
 
+/** A growable pool of fixed size items, that can be used by any number
+ *  of threads without locking.
+ *
+ *  Each thread caches free items in two "magazines" (small arrays of
+ *  item pointers). Items are allocated from, and released to the calling
+ *  thread's magazines, regardless of which thread allocated them.
+ *  Full and empty magazines are exchanged with a shared depot (lock-free
+ *  stacks), so most operations do not touch shared state at all.
+ *
+ *  If the depot runs out of items, alloc() grows the pool. This allocates
+ *  memory, so refill() should be called periodically from a non-realtime
+ *  thread to keep enough items available. refill() also keeps spare empty
+ *  magazines in the depot, so that release() does not allocate memory.
+ *
+ *  Threads should call create_thread_cache() before using the pool, otherwise
+ *  the thread's cache is allocated on first use. The pool must outlive all
+ *  threads that use it.
+ */
+class LIBPBD_API MagazinePool
+{
+public:
+	MagazinePool (std::string name, unsigned long item_size, unsigned long nitems);
+	~MagazinePool ();
+
+	void* alloc ();
+	void  release (void*);
+
+	void create_thread_cache ();
+	bool has_thread_cache () const;
+
+	void reserve (unsigned long nitems);
+	void refill ();
+
+	std::string name () const
+	{
+		return _name;
+	}
+	guint total () const
+	{
+		return _total.load ();
+	}
+	guint used () const
+	{
+		return _used.load ();
+	}
+	guint available () const
+	{
+		return total () - used ();
+	}
+
+	/** @return the number of items that the calling thread can allocate
+	 *  without growing the pool. Unlike available() this does not include
+	 *  items cached by other threads.
+	 */
+	guint thread_available ();
+
+	struct Stats {
+		guint total;
+		guint used;
+		guint high_water;    ///< max. number of items in use at the same time
+		guint exhausted;     ///< number of times that alloc() had to grow the pool
+		guint lazy_caches;   ///< number of thread caches that were not created in advance
+	};
+
+	Stats stats () const;
+	void  reset_stats ();
+
+private:
+	enum {
+		MagazineSize = 16,
+		ChunkSize    = 256,
+		MaxChunks    = 256
+	};
+
+	struct Magazine {
+		std::atomic<uint32_t> next; ///< depot link
+		uint32_t              id;
+		uint32_t              n_items;
+		void*                 items[MagazineSize];
+	};
+
+	struct ThreadCache {
+		MagazinePool* pool;
+		Magazine*     loaded;
+		Magazine*     previous;
+	};
+
+	struct Depot {
+		Depot (uint64_t h)
+			: head (h)
+			, n_magazines (0)
+			, n_items (0)
+		{}
+
+		std::atomic<uint64_t> head;
+		/* push() and pop() update these after the fact,
+		 * they may briefly be negative */
+		std::atomic<int> n_magazines;
+		std::atomic<int> n_items;
+	};
+
+	static void free_thread_cache (void*);
+
+	ThreadCache* thread_cache ();
+	Magazine*    new_magazine ();
+	Magazine*    ensure_chunk (uint32_t chunk);
+	Magazine*    get_magazine (uint32_t id) const;
+	Magazine*    new_items ();
+	Magazine*    pop (Depot&);
+	void         push (Depot&, Magazine*);
+
+	std::string   _name;
+	unsigned long _item_size;
+
+	Glib::Threads::Private<ThreadCache> _cache;
+
+	Depot _full;
+	Depot _empty;
+
+	std::atomic<Magazine*>* _chunks;
+	std::atomic<uint32_t>   _n_magazines;
+	std::atomic<void*>      _slabs;
+
+	std::atomic<guint> _n_caches;
+	std::atomic<guint> _reserve;
+	std::atomic<guint> _total;
+	std::atomic<guint> _used;
+	std::atomic<guint> _high_water;
+	std::atomic<guint> _exhausted;
+	std::atomic<guint> _lazy_caches;
+};
+
 } // namespace PBD
 
 #endif // __qm_pool_h__
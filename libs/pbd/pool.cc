@@ -20,9 +20,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
+#include <new>
 #include <vector>
 
 #include "pbd/compose.h"
@@ -305,3 +307,395 @@ CrossThreadPool::empty ()
 {
 	return (free_list.write_space () == pending.read_space ());
 }
+
+/*-------------------------------------------------------*/
+
+#define MAGAZINE_NIL 0xffffffff
+
+MagazinePool::MagazinePool (string n, unsigned long item_size, unsigned long nitems)
+	: _name (n)
+	, _item_size ((item_size + 15) & ~15UL)
+	, _cache (free_thread_cache)
+	, _full (MAGAZINE_NIL)
+	, _empty (MAGAZINE_NIL)
+	, _chunks (new std::atomic<Magazine*>[MaxChunks])
+	, _n_magazines (0)
+	, _slabs (0)
+	, _n_caches (0)
+	, _reserve (0)
+	, _total (0)
+	, _used (0)
+	, _high_water (0)
+	, _exhausted (0)
+	, _lazy_caches (0)
+{
+	for (int i = 0; i < MaxChunks; ++i) {
+		_chunks[i].store (0);
+	}
+	reserve (nitems);
+}
+
+MagazinePool::~MagazinePool ()
+{
+	DEBUG_TRACE (DEBUG::Pool, string_compose ("MagazinePool: '%1' max: %2 / %3, exhausted %4 times\n", name (), _high_water.load (), total (), _exhausted.load ()));
+
+	/* all other threads using the pool must have terminated by now */
+	ThreadCache* tc = _cache.get ();
+	if (tc) {
+		_cache.set (0);
+		free (tc);
+	}
+
+	void* slab = _slabs.load ();
+	while (slab) {
+		void* next = *static_cast<void**> (slab);
+		free (slab);
+		slab = next;
+	}
+
+	for (int i = 0; i < MaxChunks; ++i) {
+		free (_chunks[i].load ());
+	}
+	delete[] _chunks;
+}
+
+/** Called when a thread that used the pool terminates,
+ *  return its magazines to the depot.
+ */
+void
+MagazinePool::free_thread_cache (void* ptr)
+{
+	ThreadCache*  tc = static_cast<ThreadCache*> (ptr);
+	MagazinePool* p  = tc->pool;
+
+	p->push (tc->loaded->n_items > 0 ? p->_full : p->_empty, tc->loaded);
+	p->push (tc->previous->n_items > 0 ? p->_full : p->_empty, tc->previous);
+	p->_n_caches.fetch_sub (1);
+	free (tc);
+}
+
+/** Set up magazines for the calling thread. This allocates memory. */
+void
+MagazinePool::create_thread_cache ()
+{
+	if (_cache.get ()) {
+		return;
+	}
+
+	Magazine* l = pop (_empty);
+	if (!l) {
+		l = new_magazine ();
+	}
+	Magazine* p = pop (_empty);
+	if (!p) {
+		p = new_magazine ();
+	}
+
+	if (!l || !p) {
+		fatal << "CRITICAL: " << _name << " MagazinePool has no more magazines" << endmsg;
+		abort (); /*NOTREACHED*/
+	}
+
+	ThreadCache* tc = static_cast<ThreadCache*> (malloc (sizeof (ThreadCache)));
+	tc->pool        = this;
+	tc->loaded      = l;
+	tc->previous    = p;
+	_cache.set (tc);
+	_n_caches.fetch_add (1);
+}
+
+bool
+MagazinePool::has_thread_cache () const
+{
+	return const_cast<Glib::Threads::Private<ThreadCache>&> (_cache).get () != 0;
+}
+
+MagazinePool::ThreadCache*
+MagazinePool::thread_cache ()
+{
+	ThreadCache* tc = _cache.get ();
+	if (!tc) {
+		DEBUG_TRACE (DEBUG::Pool, string_compose ("%1 %2 creates thread cache on demand\n", pthread_name (), name ()));
+		_lazy_caches.fetch_add (1);
+		create_thread_cache ();
+		tc = _cache.get ();
+	}
+	return tc;
+}
+
+/** @return a new empty magazine, or 0 if the maximum number was reached */
+MagazinePool::Magazine*
+MagazinePool::new_magazine ()
+{
+	uint32_t id = _n_magazines.fetch_add (1);
+	if (id >= (uint32_t)ChunkSize * MaxChunks) {
+		_n_magazines.fetch_sub (1);
+		return 0;
+	}
+
+	Magazine* m = &ensure_chunk (id / ChunkSize)[id % ChunkSize];
+	m->next.store (MAGAZINE_NIL);
+	m->id      = id;
+	m->n_items = 0;
+	return m;
+}
+
+/** @return the given chunk of magazines, allocate it if needed */
+MagazinePool::Magazine*
+MagazinePool::ensure_chunk (uint32_t n)
+{
+	std::atomic<Magazine*>& chunk = _chunks[n];
+	Magazine*               c     = chunk.load ();
+
+	if (!c) {
+		/* since some overloaded ::operator new() might use this,
+		 * use a "lower level" allocator
+		 */
+		Magazine* nc = static_cast<Magazine*> (malloc (ChunkSize * sizeof (Magazine)));
+		for (int i = 0; i < ChunkSize; ++i) {
+			new (&nc[i]) Magazine;
+		}
+		if (chunk.compare_exchange_strong (c, nc)) {
+			c = nc;
+		} else {
+			/* another thread was faster */
+			free (nc);
+		}
+	}
+	return c;
+}
+
+MagazinePool::Magazine*
+MagazinePool::get_magazine (uint32_t id) const
+{
+	return &_chunks[id / ChunkSize].load ()[id % ChunkSize];
+}
+
+/** @return a full magazine with newly allocated items */
+MagazinePool::Magazine*
+MagazinePool::new_items ()
+{
+	Magazine* m = pop (_empty);
+	if (!m) {
+		m = new_magazine ();
+	}
+	if (!m) {
+		return 0;
+	}
+
+	/* the first 16 bytes of a slab link all slabs, for the d'tor */
+	char* slab = static_cast<char*> (malloc (16 + MagazineSize * _item_size));
+	if (!slab) {
+		push (_empty, m);
+		return 0;
+	}
+
+	void* head = _slabs.load ();
+	do {
+		*reinterpret_cast<void**> (slab) = head;
+	} while (!_slabs.compare_exchange_weak (head, slab));
+
+	for (int i = 0; i < MagazineSize; ++i) {
+		m->items[i] = slab + 16 + i * _item_size;
+	}
+	m->n_items = MagazineSize;
+	_total.fetch_add (MagazineSize);
+	return m;
+}
+
+/* The depot stacks store the magazine's id in the lower 32 bits,
+ * and a counter in the upper 32 bits to avoid the ABA problem.
+ */
+MagazinePool::Magazine*
+MagazinePool::pop (Depot& d)
+{
+	uint64_t head = d.head.load (std::memory_order_acquire);
+	for (;;) {
+		uint32_t id = head & 0xffffffff;
+		if (id == MAGAZINE_NIL) {
+			return 0;
+		}
+		Magazine* m    = get_magazine (id);
+		uint64_t  next = (((head >> 32) + 1) << 32) | m->next.load (std::memory_order_relaxed);
+		if (d.head.compare_exchange_weak (head, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			d.n_magazines.fetch_sub (1);
+			d.n_items.fetch_sub (m->n_items);
+			return m;
+		}
+	}
+}
+
+void
+MagazinePool::push (Depot& d, Magazine* m)
+{
+	/* m may be popped by another thread as soon as it was pushed */
+	d.n_magazines.fetch_add (1);
+	d.n_items.fetch_add (m->n_items);
+
+	uint64_t head = d.head.load (std::memory_order_relaxed);
+	uint64_t next;
+	do {
+		m->next.store (head & 0xffffffff, std::memory_order_relaxed);
+		next = (((head >> 32) + 1) << 32) | m->id;
+	} while (!d.head.compare_exchange_weak (head, next, std::memory_order_release, std::memory_order_relaxed));
+}
+
+/** Allocate an item. This is lock-free, and only allocates
+ *  memory if the pool is exhausted.
+ *  @return Pointer to free item, or 0 if memory is exhausted.
+ */
+void*
+MagazinePool::alloc ()
+{
+	ThreadCache* tc = thread_cache ();
+	Magazine*    l  = tc->loaded;
+
+	if (l->n_items == 0) {
+		if (tc->previous->n_items > 0) {
+			tc->loaded   = tc->previous;
+			tc->previous = l;
+		} else {
+			Magazine* m = pop (_full);
+			if (!m) {
+				_exhausted.fetch_add (1);
+				DEBUG_TRACE (DEBUG::Pool, string_compose ("%1 %2 is exhausted, growing, size %3 used %4\n", pthread_name (), name (), total (), used ()));
+				m = new_items ();
+				if (!m) {
+					return 0;
+				}
+			}
+			push (_empty, tc->previous);
+			tc->previous = l;
+			tc->loaded   = m;
+		}
+		l = tc->loaded;
+	}
+
+	void* ptr = l->items[--l->n_items];
+
+	guint u  = _used.fetch_add (1) + 1;
+	guint hw = _high_water.load ();
+	while (u > hw && !_high_water.compare_exchange_weak (hw, u)) ;
+
+	return ptr;
+}
+
+/** Release an item to the calling thread's cache.
+ *  The item may have been allocated by any thread.
+ */
+void
+MagazinePool::release (void* ptr)
+{
+	if (!ptr) {
+		return;
+	}
+
+	ThreadCache* tc = thread_cache ();
+	Magazine*    l  = tc->loaded;
+
+	if (l->n_items == MagazineSize) {
+		if (tc->previous->n_items < MagazineSize) {
+			tc->loaded   = tc->previous;
+			tc->previous = l;
+		} else {
+			Magazine* m = pop (_empty);
+			if (!m) {
+				/* refill() keeps spare magazines in the depot and
+				 * pre-allocates the next chunk, so this does not
+				 * usually allocate memory either.
+				 */
+				DEBUG_TRACE (DEBUG::Pool, string_compose ("%1 %2 has no spare magazines\n", pthread_name (), name ()));
+				m = new_magazine ();
+			}
+			if (!m) {
+				fatal << "CRITICAL: " << _name << " MagazinePool has no more magazines" << endmsg;
+				abort (); /*NOTREACHED*/
+			}
+			push (_full, tc->previous);
+			tc->previous = l;
+			tc->loaded   = m;
+		}
+		l = tc->loaded;
+	}
+
+	l->items[l->n_items++] = ptr;
+	_used.fetch_sub (1);
+}
+
+/** Keep at least @a nitems available, and grow the pool now if needed.
+ *  This is not realtime safe.
+ */
+void
+MagazinePool::reserve (unsigned long nitems)
+{
+	guint r = _reserve.load ();
+	while (nitems > r && !_reserve.compare_exchange_weak (r, nitems)) ;
+	refill ();
+}
+
+/** Grow the pool, if there are fewer items in the depot than reserved,
+ *  and replenish spare empty magazines for release().
+ *  This is not realtime safe.
+ */
+void
+MagazinePool::refill ()
+{
+	/* items cached by other threads cannot be allocated by
+	 * the realtime threads, only count the items in the depot.
+	 */
+	while (_full.n_items.load () < (int)_reserve.load ()) {
+		Magazine* m = new_items ();
+		if (!m) {
+			break;
+		}
+		push (_full, m);
+	}
+
+	/* every thread may hold two partially filled magazines,
+	 * when releasing items it needs further empty magazines.
+	 */
+	int const spares = 2 * _n_caches.load () + 2;
+	while (_empty.n_magazines.load () < spares) {
+		Magazine* m = new_magazine ();
+		if (!m) {
+			return;
+		}
+		push (_empty, m);
+	}
+
+	uint32_t next_chunk = (_n_magazines.load () + spares) / ChunkSize;
+	if (next_chunk < MaxChunks) {
+		ensure_chunk (next_chunk);
+	}
+}
+
+guint
+MagazinePool::thread_available ()
+{
+	int          n  = std::max (0, _full.n_items.load ());
+	ThreadCache* tc = _cache.get ();
+	if (tc) {
+		n += tc->loaded->n_items + tc->previous->n_items;
+	}
+	return n;
+}
+
+MagazinePool::Stats
+MagazinePool::stats () const
+{
+	Stats s;
+	s.total       = total ();
+	s.used        = used ();
+	s.high_water  = _high_water.load ();
+	s.exhausted   = _exhausted.load ();
+	s.lazy_caches = _lazy_caches.load ();
+	return s;
+}
+
+void
+MagazinePool::reset_stats ()
+{
+	_high_water.store (used ());
+	_exhausted.store (0);
+	_lazy_caches.store (0);
+}
@@ -100,6 +100,12 @@ Semaphore::reset ()
 	return rv;
 }
 
+bool
+Semaphore::try_wait ()
+{
+	return WaitForSingleObject(_sem, 0) == WAIT_OBJECT_0;
+}
+
 #elif defined USE_FUTEX_SEMAPHORE
 
 int
@@ -130,4 +136,16 @@ Semaphore::reset ()
 	return value;
 }
 
+bool
+Semaphore::try_wait ()
+{
+	int value = _value.load (std::memory_order_relaxed);
+	while (value > 0) {
+		if (_value.compare_exchange_weak (value, value - 1, std::memory_order_relaxed)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 #endif
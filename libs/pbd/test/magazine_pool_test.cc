@@ -0,0 +1,197 @@
+#include <set>
+#include <vector>
+#include <sched.h>
+
+#include "magazine_pool_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MagazinePoolTest);
+
+using namespace std;
+using namespace PBD;
+
+MagazinePoolTest::MagazinePoolTest ()
+	: _pool (0)
+{
+}
+
+void
+MagazinePoolTest::testBasic ()
+{
+	MagazinePool* p = new MagazinePool ("TestPool", 24, 64);
+	p->create_thread_cache ();
+
+	CPPUNIT_ASSERT (p->total () >= 64);
+	CPPUNIT_ASSERT_EQUAL (0U, p->used ());
+
+	/* allocate more than the initial size, the pool has to grow */
+	set<void*> items;
+	for (int i = 0; i < 1000; ++i) {
+		void* x = p->alloc ();
+		CPPUNIT_ASSERT (x);
+		CPPUNIT_ASSERT (items.insert (x).second);
+	}
+
+	MagazinePool::Stats s = p->stats ();
+	CPPUNIT_ASSERT_EQUAL (1000U, s.used);
+	CPPUNIT_ASSERT_EQUAL (1000U, s.high_water);
+	CPPUNIT_ASSERT (s.total >= 1000);
+	CPPUNIT_ASSERT (s.exhausted > 0);
+	CPPUNIT_ASSERT_EQUAL (0U, s.lazy_caches);
+
+	for (set<void*>::iterator i = items.begin (); i != items.end (); ++i) {
+		p->release (*i);
+	}
+	CPPUNIT_ASSERT_EQUAL (0U, p->used ());
+
+	/* released items are re-used */
+	guint total = p->total ();
+	for (int i = 0; i < 1000; ++i) {
+		items.erase (p->alloc ());
+	}
+	CPPUNIT_ASSERT (items.empty ());
+	CPPUNIT_ASSERT_EQUAL (total, p->total ());
+
+	delete p;
+}
+
+static void*
+launch_worker (void* arg)
+{
+	std::pair<MagazinePoolTest*, int>* w = static_cast<std::pair<MagazinePoolTest*, int>*> (arg);
+	w->first->worker (w->second);
+	return NULL;
+}
+
+void
+MagazinePoolTest::worker (int id)
+{
+	/* half of the threads do not set up their cache in advance */
+	if (id % 2) {
+		_pool->create_thread_cache ();
+	}
+
+	for (int n = 0; n < 100000; ++n) {
+		std::atomic<int>* x = static_cast<std::atomic<int>*> (_pool->alloc ());
+		if (!x) {
+			++_errors;
+			continue;
+		}
+		x->store (id);
+
+		/* pass the item on, to be released by some other thread */
+		std::atomic<int>* y = static_cast<std::atomic<int>*> (_slots[(n * 7 + id) % NumSlots].exchange (x));
+		if (y) {
+			y->store (-1);
+			_pool->release (y);
+		}
+	}
+}
+
+void
+MagazinePoolTest::testCrossThread ()
+{
+	_pool   = new MagazinePool ("TestPool", sizeof (std::atomic<int>), 64);
+	_errors = 0;
+
+	for (int i = 0; i < NumSlots; ++i) {
+		_slots[i] = 0;
+	}
+
+	pthread_t                         threads[NumThreads];
+	std::pair<MagazinePoolTest*, int> args[NumThreads];
+
+	for (int i = 0; i < NumThreads; ++i) {
+		args[i] = std::make_pair (this, i);
+		CPPUNIT_ASSERT (pthread_create (&threads[i], NULL, launch_worker, &args[i]) == 0);
+	}
+	for (int i = 0; i < NumThreads; ++i) {
+		CPPUNIT_ASSERT (pthread_join (threads[i], NULL) == 0);
+	}
+
+	CPPUNIT_ASSERT_EQUAL (0, _errors.load ());
+
+	set<void*> items;
+	for (int i = 0; i < NumSlots; ++i) {
+		void* y = _slots[i].load ();
+		if (y) {
+			CPPUNIT_ASSERT (items.insert (y).second);
+			_pool->release (y);
+		}
+	}
+
+	MagazinePool::Stats s = _pool->stats ();
+	CPPUNIT_ASSERT_EQUAL (0U, s.used);
+	CPPUNIT_ASSERT (s.high_water <= s.total);
+	CPPUNIT_ASSERT (s.lazy_caches >= NumThreads / 2);
+
+	delete _pool;
+	_pool = 0;
+}
+
+static void*
+launch_hoarder (void* arg)
+{
+	static_cast<MagazinePoolTest*> (arg)->hoarder ();
+	return NULL;
+}
+
+void
+MagazinePoolTest::hoarder ()
+{
+	_pool->create_thread_cache ();
+
+	vector<void*> items;
+	for (int i = 0; i < 40; ++i) {
+		items.push_back (_pool->alloc ());
+	}
+	for (vector<void*>::iterator i = items.begin (); i != items.end (); ++i) {
+		_pool->release (*i);
+	}
+
+	/* keep the released items in this thread's cache */
+	_state = 1;
+	while (_state.load () != 2) {
+		sched_yield ();
+	}
+}
+
+void
+MagazinePoolTest::testReserve ()
+{
+	_pool  = new MagazinePool ("TestPool", 24, 64);
+	_state = 0;
+	_pool->create_thread_cache ();
+
+	CPPUNIT_ASSERT (_pool->thread_available () >= 64);
+
+	pthread_t thread;
+	CPPUNIT_ASSERT (pthread_create (&thread, NULL, launch_hoarder, this) == 0);
+	while (_state.load () != 1) {
+		sched_yield ();
+	}
+
+	/* items cached by the other thread cannot be allocated here */
+	CPPUNIT_ASSERT_EQUAL (0U, _pool->used ());
+	CPPUNIT_ASSERT (_pool->thread_available () < _pool->available ());
+
+	/* refill() restores the reserve, not counting other thread's items */
+	_pool->refill ();
+	CPPUNIT_ASSERT (_pool->thread_available () >= 64);
+	CPPUNIT_ASSERT (_pool->available () > _pool->thread_available ());
+
+	/* items can be allocated without growing the pool */
+	vector<void*> items;
+	for (int i = 0; i < 64; ++i) {
+		items.push_back (_pool->alloc ());
+	}
+	CPPUNIT_ASSERT_EQUAL (0U, _pool->stats ().exhausted);
+	for (vector<void*>::iterator i = items.begin (); i != items.end (); ++i) {
+		_pool->release (*i);
+	}
+
+	_state = 2;
+	CPPUNIT_ASSERT (pthread_join (thread, NULL) == 0);
+
+	delete _pool;
+	_pool = 0;
+}
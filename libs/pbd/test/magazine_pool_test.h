@@ -0,0 +1,32 @@
+#include <atomic>
+#include <pthread.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "pbd/pool.h"
+
+class MagazinePoolTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MagazinePoolTest);
+	CPPUNIT_TEST (testBasic);
+	CPPUNIT_TEST (testCrossThread);
+	CPPUNIT_TEST (testReserve);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	MagazinePoolTest ();
+	void testBasic ();
+	void testCrossThread ();
+	void testReserve ();
+
+	void worker (int id);
+	void hoarder ();
+
+private:
+	enum { NumThreads = 8, NumSlots = 64 };
+
+	PBD::MagazinePool* _pool;
+	std::atomic<void*> _slots[NumSlots];
+	std::atomic<int>   _errors;
+	std::atomic<int>   _state;
+};
@@ -229,6 +229,34 @@ Convproc::impdata_clear (uint32_t inp, uint32_t out)
 	return 0;
 }
 
+int
+Convproc::impdata_share (Convproc const* src)
+{
+	uint32_t k;
+
+	if (_state != ST_STOP || !src || src->_state < ST_STOP) {
+		return Converror::BAD_STATE;
+	}
+	if ((src->_nlevels != _nlevels) || (src->_ninp != _ninp) || (src->_nout != _nout)) {
+		return Converror::BAD_PARAM;
+	}
+	for (k = 0; k < _nlevels; k++) {
+		if (!_convlev[k]->same_layout (src->_convlev[k])) {
+			return Converror::BAD_PARAM;
+		}
+	}
+
+	try {
+		for (k = 0; k < _nlevels; k++) {
+			_convlev[k]->impdata_share (src->_convlev[k]);
+		}
+	} catch (...) {
+		cleanup ();
+		return Converror::MEM_ALLOC;
+	}
+	return 0;
+}
+
 int
 Convproc::reset (void)
 {
@@ -250,7 +278,7 @@ Convproc::reset (void)
 }
 
 int
-Convproc::start_process (int abspri, int policy)
+Convproc::start_process (int abspri, int policy, Convsched* sched)
 {
 	uint32_t k;
 
@@ -263,7 +291,11 @@ Convproc::start_process (int abspri, int policy)
 	reset ();
 
 	for (k = (_minpart == _quantum) ? 1 : 0; k < _nlevels; k++) {
-		_convlev[k]->start (abspri, policy);
+		if (sched) {
+			_convlev[k]->start (sched);
+		} else {
+			_convlev[k]->start (abspri, policy);
+		}
 	}
 
 	while (!check_started ((_minpart == _quantum) ? 1 : 0)) {
@@ -435,6 +467,7 @@ Convlevel::Convlevel (void)
 #ifndef PTW32_VERSION
 	, _pthr (0)
 #endif
+	, _sched (0)
 	, _inp_list (0)
 	, _out_list (0)
 	, _plan_r2c (0)
@@ -631,10 +664,25 @@ Convlevel::start (int abspri, int policy)
 	pthread_attr_destroy (&attr);
 }
 
+void
+Convlevel::start (Convsched* sched)
+{
+	_sched = sched;
+	_stat  = ST_PROC;
+}
+
 void
 Convlevel::stop (void)
 {
-	if (_stat != ST_IDLE) {
+	if (_stat != ST_IDLE && _sched) {
+		/* wait for scheduled cycles to complete */
+		while (_wait) {
+			_done.wait ();
+			_wait--;
+		}
+		_sched = 0;
+		_stat  = ST_IDLE;
+	} else if (_stat != ST_IDLE) {
 		_stat = ST_TERM;
 		_trig.post ();
 	}
@@ -828,7 +876,11 @@ Convlevel::readout ()
 			if (++_opind == 3) {
 				_opind = 0;
 			}
-			_trig.post ();
+			if (_sched) {
+				_sched->schedule (this);
+			} else {
+				_trig.post ();
+			}
 			_wait++;
 		} else {
 			process ();
@@ -932,6 +984,83 @@ Convlevel::findmacnode (uint32_t inp, uint32_t out, bool create)
 	return M;
 }
 
+bool
+Convlevel::same_layout (Convlevel const* L) const
+{
+	return (_offs == L->_offs) && (_npar == L->_npar) && (_parsize == L->_parsize) && (_options == L->_options);
+}
+
+void
+Convlevel::impdata_share (Convlevel const* L)
+{
+	Outnode const* Y;
+	Macnode*       M;
+	Macnode*       N;
+
+	for (Y = L->_out_list; Y; Y = Y->_next) {
+		for (M = Y->_list; M; M = M->_next) {
+			Macnode* S = M->_link ? M->_link : M;
+			if (S->_fftb == 0) {
+				continue;
+			}
+			N = findmacnode (M->_inpn->_inp, Y->_out, true);
+			if (N && N->_fftb == 0) {
+				N->_link = S;
+			}
+		}
+	}
+}
+
+void
+Convsched::run (Convlevel* L)
+{
+	L->process ();
+	L->_done.post ();
+}
+
+void
+Convsched::skip (Convlevel* L)
+{
+	L->skip ();
+	L->_done.post ();
+}
+
+uint32_t
+Convsched::parsize (Convlevel const* L)
+{
+	return L->_parsize;
+}
+
+/* Like process (), advance the input and partition position, but instead
+ * of the spectrum of the current input partition, use silence.
+ * The output of this partition is silent, and it does not contribute
+ * to later partitions either.
+ */
+void
+Convlevel::skip ()
+{
+	Inpnode const* X;
+	Outnode const* Y;
+
+	_inpoffs += _parsize;
+	if (_inpoffs >= _inpsize) {
+		_inpoffs -= _inpsize;
+	}
+
+	for (X = _inp_list; X; X = X->_next) {
+		memset (X->_ffta[_ptind], 0, (_parsize + 1) * sizeof (fftwf_complex));
+	}
+
+	for (Y = _out_list; Y; Y = Y->_next) {
+		memset (Y->_buff[(_opind + 2) % 3], 0, _parsize * sizeof (float));
+	}
+
+	_ptind++;
+	if (_ptind == _npar) {
+		_ptind = 0;
+	}
+}
+
 #ifdef ENABLE_VECTOR_MODE
 
 void
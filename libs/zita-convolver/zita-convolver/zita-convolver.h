@@ -225,10 +225,34 @@ private:
 	int _error;
 };
 
+class Convlevel;
+
+/* Optional external scheduler for partitions that are not processed
+ * in the caller's thread. Instead of each level running a dedicated
+ * thread, schedule() is called from Convproc::process(), and the
+ * scheduler must eventually call run() for the given level from some
+ * other thread.
+ */
+class LIBZCONVOLVER_API Convsched
+{
+public:
+	virtual ~Convsched () {}
+	virtual void schedule (Convlevel*) = 0;
+
+protected:
+	/* process the level, and signal completion */
+	static void     run (Convlevel*);
+	/* drop a partition that cannot be processed in time: its
+	 * contribution to the output is silent, signal completion */
+	static void     skip (Convlevel*);
+	static uint32_t parsize (Convlevel const*);
+};
+
 class LIBZCONVOLVER_API Convlevel
 {
 private:
 	friend class Convproc;
+	friend class Convsched;
 
 	enum {
 		OPT_FFTW_MEASURE = 1,
@@ -268,8 +292,10 @@ private:
 	            float**  outbuff);
 
 	void start (int absprio, int policy);
+	void start (Convsched*);
 
 	void process ();
+	void skip ();
 
 	int readout ();
 	int readtail (uint32_t n_samples);
@@ -288,6 +314,9 @@ private:
 
 	Macnode* findmacnode (uint32_t inp, uint32_t out, bool create);
 
+	bool same_layout (Convlevel const*) const;
+	void impdata_share (Convlevel const*);
+
 	volatile uint32_t _stat;      // current processing state
 	int               _prio;      // relative priority
 	uint32_t          _offs;      // offset from start of impulse response
@@ -303,6 +332,7 @@ private:
 	int               _bits;      // bit identifiying this level
 	int               _wait;      // number of unfinished cycles
 	pthread_t         _pthr;      // posix thread executing this level
+	Convsched*        _sched;     // external scheduler, instead of _pthr
 	ZCsema            _trig;      // sema used to trigger a cycle
 	ZCsema            _done;      // sema used to wait for a cycle
 	Inpnode*          _inp_list;  // linked list of active inputs
@@ -386,11 +416,17 @@ public:
 	int impdata_clear (uint32_t inp,
 	                   uint32_t out);
 
+	/* use the impulse response data of another instance, instead of
+	 * creating it. Both must have been configured with identical parameters,
+	 * and src must not be cleaned up while this instance is in use.
+	 */
+	int impdata_share (Convproc const* src);
+
 	void set_options (uint32_t options);
 
 	int reset (void);
 
-	int start_process (int abspri, int policy);
+	int start_process (int abspri, int policy, Convsched* sched = 0);
 
 	int process ();
 	int tailonly (uint32_t n_samples);
@@ -0,0 +1,403 @@
+// ----------------------------------------------------------------------------
+//
+//  Copyright (C) 2006-2013 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2017 Robin Gareus <robin@gareus.org>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#include "zita-resampler/vmcresampler.h"
+
+using namespace ArdourZita;
+
+VMCResampler::VMCResampler (void)
+	: _table (0)
+	, _reset (false)
+	, _maxout (0)
+	, _mode (COPY)
+	, _p_inp (0)
+	, _p_out (0)
+	, _p_len (0)
+	, _p_step (0)
+	, _p_copy (0)
+	, _p_coef (0)
+{
+	reset ();
+}
+
+VMCResampler::~VMCResampler (void)
+{
+	clear ();
+}
+
+unsigned int
+VMCResampler::bufsize (unsigned int hlen)
+{
+	if ((hlen < 8) || (hlen > 96)) return 0;
+	return 2 * hlen - 1 + 250;
+}
+
+int
+VMCResampler::setup (unsigned int hlen, unsigned int maxout)
+{
+	if ((hlen < 8) || (hlen > 96)) {
+		/* no resampling, prepare() sets up a plain copy */
+		clear ();
+		return 1;
+	}
+	return setup (hlen, 1.0 - 2.6 / hlen, maxout);
+}
+
+int
+VMCResampler::setup (unsigned int hlen, double frel, unsigned int maxout)
+{
+	unsigned int       h, k, n;
+	double             s;
+	Resampler_table    *T = 0;
+
+	n = NPHASE;
+	s = n;
+	h = hlen;
+	k = 250;
+	T = Resampler_table::create (frel, h, n);
+	clear ();
+	if (T) {
+		_table  = T;
+		_maxout = maxout;
+		_p_step = new unsigned int [maxout];
+		_p_copy = new bool [maxout];
+		_p_coef = new float [2 * h * maxout];
+		_inmax  = k;
+		_pstep  = s;
+		_qstep  = s;
+		_wstep  = 1;
+		return reset ();
+	}
+	else return 1;
+}
+
+void
+VMCResampler::clear (void)
+{
+	Resampler_table::destroy (_table);
+	delete[] _p_step;
+	delete[] _p_copy;
+	delete[] _p_coef;
+	_p_step = 0;
+	_p_copy = 0;
+	_p_coef = 0;
+	_maxout = 0;
+	_table = 0;
+	_inmax = 0;
+	_pstep = 0;
+	_qstep = 0;
+	_wstep = 1;
+	_reset = false;
+	reset ();
+}
+
+void
+VMCResampler::set_phase (double p)
+{
+	if (!_table) return;
+	_phase = (p - floor (p)) * _table->_np;
+}
+
+void
+VMCResampler::set_rrfilt (double t)
+{
+	if (!_table) return;
+	_wstep =  (t < 1) ? 1 : 1 - exp (-1 / t);
+}
+
+double
+VMCResampler::set_rratio (double r)
+{
+	if (!_table) return 0;
+	if (r > 16.0) r = 16.0;
+	if (r < 0.02) r = 0.02;
+
+	_qstep = _table->_np / r;
+
+	if (_qstep < 4.) {
+		_qstep = 4.;
+	}
+	if (_qstep > 2. * _table->_np * _table->_hl) {
+		_qstep = 2. * _table->_np * _table->_hl;
+	}
+	return _table->_np / _qstep;
+}
+
+double
+VMCResampler::inpdist (void) const
+{
+	if (!_table) return 0;
+	return (int)(_table->_hl + 1 - _nread) - _phase / _table->_np;
+}
+
+int
+VMCResampler::inpsize (void) const
+{
+	if (!_table) return 0;
+	return 2 * _table->_hl;
+}
+
+int
+VMCResampler::reset (void)
+{
+	if (!_table) return 1;
+	if (_reset) return 0;
+
+	inp_count = 0;
+	out_count = 0;
+	_index = 0;
+	_phase = 0;
+	_nread = _table->_hl + 1;
+	_mode = COPY;
+	_p_inp = 0;
+	_p_out = 0;
+	_reset = true;
+	return 0;
+}
+
+void
+VMCResampler::reset_channel (float *buff) const
+{
+	if (!_table) return;
+	memset (buff, 0, sizeof (float) * bufsize (_table->_hl));
+}
+
+int
+VMCResampler::prepare (void)
+{
+	unsigned int   in, nr, n, j;
+	double         ph, dp;
+
+	if (!_table) {
+		n = std::min (inp_count, out_count);
+		_mode = COPY;
+		_p_out = n;
+		out_count -= n;
+		inp_count -= n;
+		return 1;
+	}
+
+	const int hl = _table->_hl;
+	const unsigned int np = _table->_np;
+	in = _index;
+	nr = _nread;
+	ph = _phase;
+	dp = _pstep;
+	n = 2 * hl - nr;
+
+	_p_index = in;
+	_p_nread = nr;
+	_p_inp   = inp_count;
+	_reset   = false;
+
+	/* optimized full-cycle no-resampling, see VMResampler::process() */
+	if (dp == np && _qstep == np && nr == 1 && inp_count == out_count) {
+		_mode  = PASSTHRU;
+		_p_out = out_count;
+
+		if (out_count >= n) {
+			in = 0;
+		} else {
+			while (out_count) {
+				unsigned int to_proc = std::min (out_count, _inmax - in);
+				out_count -= to_proc;
+				in        += to_proc;
+				if (in >= _inmax) {
+					in = 0;
+				}
+			}
+		}
+		_index = in;
+		inp_count = 0;
+		out_count = 0;
+		return 0;
+	}
+
+	/* the plan is limited to @a maxout samples, remaining
+	 * output is left for the caller to handle.
+	 */
+	_mode  = RESAMPLE;
+	_p_out = std::min (out_count, _maxout);
+	out_count -= _p_out;
+
+	unsigned int oc = _p_out;
+	j = 0;
+
+	while (oc) {
+		if (nr) {
+			if (inp_count == 0) break;
+			nr--;
+			inp_count--;
+		} else {
+			if (dp == np) {
+				_p_copy[j] = true;
+			} else {
+				const unsigned int k = (unsigned int) ph;
+				const float bb = (float)(ph - k);
+				const float aa = 1.0f - bb;
+				float const* cq1 = _table->_ctab + hl * k;
+				float const* cq2 = _table->_ctab + hl * (np - k);
+				float* c1 = _p_coef + 2 * hl * j;
+				float* c2 = c1 + hl;
+				for (int i = 0; i < hl; i++) {
+					c1 [i] = aa * cq1 [i] + bb * cq1 [i + hl];
+					c2 [i] = aa * cq2 [i] + bb * cq2 [i - hl];
+				}
+				_p_copy[j] = false;
+			}
+			oc--;
+
+			const double dd = _qstep - dp;
+			if (fabs (dd) < 1e-12) {
+				dp = _qstep;
+			} else {
+				dp += _wstep * dd;
+			}
+			ph += dp;
+
+			if (ph >= np) {
+				nr = (unsigned int) floor (ph / np);
+				ph -= nr * np;
+				in += nr;
+				if (in >= _inmax) {
+					in = 0;
+				}
+			}
+			_p_step[j++] = nr;
+		}
+	}
+
+	/* output that could not be produced due to lack of input */
+	out_count += oc;
+	_p_len = j;
+	_p_inp -= inp_count;
+
+	_index = in;
+	_nread = nr;
+	_phase = ph;
+	_pstep = dp;
+
+	return 0;
+}
+
+unsigned int
+VMCResampler::process (float *buff, float const *inp_data, float *out_data) const
+{
+	unsigned int   in, nr, n, ic;
+	float          a, *p1, *p2;
+
+	switch (_mode) {
+		case COPY:
+			memcpy (out_data, inp_data, _p_out * sizeof (float));
+			return _p_out;
+		case PASSTHRU:
+			break;
+		case RESAMPLE:
+			break;
+	}
+
+	const int hl = _table->_hl;
+	in = _p_index;
+	nr = _p_nread;
+	n = 2 * hl - nr;
+
+	if (_mode == PASSTHRU) {
+		unsigned int oc = _p_out;
+
+		if (oc >= n) {
+			const unsigned int h1 = hl - 1;
+			const unsigned int head = oc - h1;
+			const unsigned int tail = oc - n;
+
+			memcpy (out_data, &buff[in + hl], h1 * sizeof (float));
+			memcpy (&out_data[h1], inp_data, head * sizeof (float));
+			memcpy (buff, &inp_data[tail], n * sizeof (float));
+			return _p_out;
+		}
+
+		while (oc) {
+			unsigned int to_proc = std::min (oc, _inmax - in);
+			memcpy (&buff[in + n], inp_data, to_proc * sizeof (float));
+			memcpy (out_data, &buff[in + hl], to_proc * sizeof (float));
+			inp_data += to_proc;
+			out_data += to_proc;
+			oc       -= to_proc;
+			in       += to_proc;
+			if (in >= _inmax) {
+				memcpy (buff, buff + in, (2 * hl - 1) * sizeof (float));
+				in = 0;
+			}
+		}
+		return _p_out;
+	}
+
+	/* replay the plan, using the same control flow as VMResampler::process() */
+	p1 = buff + in;
+	p2 = p1 + n;
+	ic = _p_inp;
+
+	float const* c1 = _p_coef;
+
+	for (unsigned int j = 0;;) {
+		if (nr) {
+			if (ic == 0) break;
+			*p2 = *inp_data;
+			inp_data++;
+			nr--;
+			p2++;
+			ic--;
+		} else {
+			if (j == _p_len) break;
+			if (_p_copy[j]) {
+				*out_data++ = p1[hl];
+			} else {
+				float const* c2 = c1 + hl;
+				a = 1e-25f;
+				for (int i = 0; i < hl; i++) {
+					a += p1[i] * c1 [i] + p2[-i-1] * c2 [i];
+				}
+				*out_data++ = a - 1e-25f;
+			}
+
+			nr = _p_step[j++];
+			c1 += 2 * hl;
+
+			if (nr) {
+				in += nr;
+				p1 += nr;
+				if (in >= _inmax) {
+					n = (2 * hl - nr);
+					memcpy (buff, p1, n * sizeof (float));
+					in = 0;
+					p1 = buff;
+					p2 = p1 + n;
+				}
+			}
+		}
+	}
+
+	return _p_len;
+}
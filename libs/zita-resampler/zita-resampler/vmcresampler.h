@@ -0,0 +1,102 @@
+// ----------------------------------------------------------------------------
+//
+//  Copyright (C) 2006-2012 Fons Adriaensen <fons@linuxaudio.org>
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// ----------------------------------------------------------------------------
+
+
+#ifndef _ZITA_VMCRESAMPLER_H_
+#define _ZITA_VMCRESAMPLER_H_
+
+#include "zita-resampler/zresampler_visibility.h"
+#include "zita-resampler/resampler-table.h"
+
+namespace ArdourZita {
+
+/* Multi-channel variant of VMResampler.
+ *
+ * All channels share the resampling ratio, phase and filter
+ * coefficients. prepare() advances the shared state and computes
+ * the interpolated filter coefficients for every output sample
+ * once; process() then applies them to a single channel.
+ *
+ * The input history of each channel is kept in a caller provided
+ * buffer of bufsize() samples, so that the set of channels can
+ * change from one cycle to the next. process() is const and can
+ * be called concurrently for different channels.
+ */
+class LIBZRESAMPLER_API VMCResampler
+{
+public:
+	VMCResampler (void);
+	~VMCResampler (void);
+
+	int  setup (unsigned int hlen, unsigned int maxout);
+	int  setup (unsigned int hlen, double frel, unsigned int maxout);
+
+	void   clear (void);
+	int    reset (void);
+	int    inpsize (void) const;
+	double inpdist (void) const;
+
+	void   set_phase (double p);
+	void   set_rrfilt (double t);
+	double set_rratio (double r);
+
+	int          prepare (void);
+	unsigned int process (float *buff, float const *inp_data, float *out_data) const;
+	void         reset_channel (float *buff) const;
+
+	static unsigned int bufsize (unsigned int hlen);
+
+	unsigned int         inp_count;
+	unsigned int         out_count;
+
+private:
+	enum { NPHASE = 256 };
+
+	enum Mode {
+		COPY,
+		PASSTHRU,
+		RESAMPLE
+	};
+
+	Resampler_table     *_table;
+	unsigned int         _inmax;
+	unsigned int         _index;
+	unsigned int         _nread;
+	double               _phase;
+	double               _pstep;
+	double               _qstep;
+	double               _wstep;
+	bool                 _reset;
+
+	/* processing plan, computed by prepare() */
+	unsigned int         _maxout;
+	Mode                 _mode;
+	unsigned int         _p_index;
+	unsigned int         _p_nread;
+	unsigned int         _p_inp;  // input samples consumed
+	unsigned int         _p_out;
+	unsigned int         _p_len;
+	unsigned int        *_p_step;
+	bool                *_p_copy;
+	float               *_p_coef;
+};
+
+};
+
+#endif
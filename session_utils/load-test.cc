@@ -0,0 +1,652 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <getopt.h>
+#include <inttypes.h>
+#include <iostream>
+#include <time.h>
+
+#include <glibmm.h>
+
+#include "pbd/file_utils.h"
+#include "pbd/microseconds.h"
+#include "pbd/semutils.h"
+
+#include "ardour/audio_backend.h"
+#include "ardour/audio_track.h"
+#include "ardour/audioengine.h"
+#include "ardour/automation_control.h"
+#include "ardour/automation_list.h"
+#include "ardour/gain_control.h"
+#include "ardour/lua_api.h"
+#include "ardour/midi_track.h"
+#include "ardour/monitor_control.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/route.h"
+#include "ardour/utils.h"
+
+#include "common.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace SessionUtils;
+
+struct LoadSpec {
+	LoadSpec ()
+		: n_tracks (16)
+		, n_busses (4)
+		, n_midi_tracks (0)
+		, n_sends (1)
+		, automation (0)
+		, sample_rate (48000)
+		, buffer_size (256)
+		, n_threads (-1)
+		, n_cycles (8192)
+		, n_warmup (256)
+		, timeout (300)
+	{}
+
+	uint32_t       n_tracks;
+	uint32_t       n_busses;
+	uint32_t       n_midi_tracks;
+	uint32_t       n_sends;      ///< aux-sends per track
+	float          automation;   ///< gain automation events per second
+	int            sample_rate;
+	uint32_t       buffer_size;
+	int            n_threads;    ///< Config processor-usage
+	uint32_t       n_cycles;
+	uint32_t       n_warmup;
+	uint32_t       timeout;      ///< seconds
+	vector<string> plugins;
+};
+
+/** Collects per-cycle DSP time while the engine is freewheeling.
+ *
+ * The engine calls ::process() instead of Session::process(), this
+ * allows to precisely time the session's process callback, and run
+ * as fast as possible, independent of the wall-clock.
+ */
+class LoadTest
+{
+public:
+	LoadTest (Session* s, LoadSpec const& spec)
+		: _session (s)
+		, _spec (spec)
+		, _cycle (0)
+		, _wall_start (0)
+		, _wall_end (0)
+		, _cpu_start (0)
+		, _cpu_end (0)
+		, _started (false)
+		, _done ("loadtest", 0)
+	{
+		_dsp.reserve (spec.n_cycles);
+	}
+
+	bool run ()
+	{
+		AudioEngine::instance ()->Freewheel.connect_same_thread (_freewheel_connection, boost::bind (&LoadTest::process, this, _1));
+		if (AudioEngine::instance ()->freewheel (true)) {
+			cerr << "Error: Cannot start freewheeling\n";
+			return false;
+		}
+		bool rv = wait ();
+		AudioEngine::instance ()->freewheel (false);
+		_freewheel_connection.disconnect ();
+		return rv;
+	}
+
+	void report (FILE* f) const;
+
+private:
+	bool wait ()
+	{
+		AudioEngine*              engine   = AudioEngine::instance ();
+		const PBD::microseconds_t deadline = PBD::get_microseconds () + _spec.timeout * (PBD::microseconds_t)1000000;
+
+		while (!_done.try_wait ()) {
+			if (!engine->running ()) {
+				cerr << "Error: Audio/MIDI engine stopped\n";
+				return false;
+			}
+			if (_started.load () && !engine->freewheeling ()) {
+				cerr << "Error: Engine stopped freewheeling\n";
+				return false;
+			}
+			if (PBD::get_microseconds () > deadline) {
+				cerr << "Error: Timeout, processed " << _cycle.load () << " of " << _spec.n_warmup + _spec.n_cycles << " cycles\n";
+				return false;
+			}
+			Glib::usleep (10000);
+		}
+		return true;
+	}
+
+	void process (pframes_t nframes)
+	{
+		_started.store (true);
+
+		if (!_session->transport_rolling () || _cycle >= _spec.n_warmup + _spec.n_cycles) {
+			_session->process (nframes);
+			return;
+		}
+
+		if (_cycle == _spec.n_warmup) {
+			_wall_start = PBD::get_microseconds ();
+			_cpu_start  = cpu_time ();
+		}
+
+		PBD::microseconds_t t0 = PBD::get_microseconds ();
+		_session->process (nframes);
+		PBD::microseconds_t t1 = PBD::get_microseconds ();
+
+		if (_cycle++ >= _spec.n_warmup) {
+			_dsp.push_back (t1 - t0);
+		}
+
+		if (_cycle == _spec.n_warmup + _spec.n_cycles) {
+			_wall_end = PBD::get_microseconds ();
+			_cpu_end  = cpu_time ();
+			_done.signal ();
+		}
+	}
+
+	static PBD::microseconds_t cpu_time ()
+	{
+		struct timespec ts;
+		clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &ts);
+		return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+	}
+
+	Session*                    _session;
+	LoadSpec const&             _spec;
+	std::atomic<uint32_t>       _cycle;
+	vector<PBD::microseconds_t> _dsp;
+	PBD::microseconds_t         _wall_start;
+	PBD::microseconds_t         _wall_end;
+	PBD::microseconds_t         _cpu_start;
+	PBD::microseconds_t         _cpu_end;
+	std::atomic<bool>           _started;
+	PBD::Semaphore              _done;
+
+	PBD::ScopedConnection _freewheel_connection;
+};
+
+static string
+json_escape (string const& s)
+{
+	string rv;
+	for (string::const_iterator i = s.begin (); i != s.end (); ++i) {
+		switch (*i) {
+			case '"':
+				rv += "\\\"";
+				break;
+			case '\\':
+				rv += "\\\\";
+				break;
+			case '\n':
+				rv += "\\n";
+				break;
+			case '\r':
+				rv += "\\r";
+				break;
+			case '\t':
+				rv += "\\t";
+				break;
+			default:
+				if ((unsigned char)*i < 0x20) {
+					char buf[8];
+					snprintf (buf, sizeof (buf), "\\u%04x", (unsigned char)*i);
+					rv += buf;
+				} else {
+					rv += *i;
+				}
+				break;
+		}
+	}
+	return rv;
+}
+
+void
+LoadTest::report (FILE* f) const
+{
+	vector<PBD::microseconds_t> dsp (_dsp);
+	sort (dsp.begin (), dsp.end ());
+
+	const size_t n      = dsp.size ();
+	const double period = 1e6 * _spec.buffer_size / (double)_spec.sample_rate;
+	const double wall   = _wall_end - _wall_start;
+	const double cpu    = _cpu_end - _cpu_start;
+
+	double   sum      = 0;
+	uint32_t overruns = 0;
+	for (size_t i = 0; i < n; ++i) {
+		sum += dsp[i];
+		if (dsp[i] > period) {
+			++overruns;
+		}
+	}
+
+	uint32_t threads = how_many_dsp_threads ();
+
+	/* nearest-rank percentile */
+#define PERCENTILE(p) (n > 0 ? dsp[std::min<size_t> (n - 1, ceil ((p) * n / 100.) - 1)] : 0)
+
+	fprintf (f, "{\n");
+	fprintf (f, "  \"spec\": {\n");
+	fprintf (f, "    \"tracks\": %u,\n", _spec.n_tracks);
+	fprintf (f, "    \"busses\": %u,\n", _spec.n_busses);
+	fprintf (f, "    \"midi_tracks\": %u,\n", _spec.n_midi_tracks);
+	fprintf (f, "    \"sends\": %u,\n", _spec.n_sends);
+	fprintf (f, "    \"automation\": %.2f,\n", _spec.automation);
+	fprintf (f, "    \"plugins\": [");
+	for (vector<string>::const_iterator i = _spec.plugins.begin (); i != _spec.plugins.end (); ++i) {
+		fprintf (f, "%s\"%s\"", i == _spec.plugins.begin () ? "" : ", ", json_escape (*i).c_str ());
+	}
+	fprintf (f, "],\n");
+	fprintf (f, "    \"samplerate\": %d,\n", _spec.sample_rate);
+	fprintf (f, "    \"buffer_size\": %u,\n", _spec.buffer_size);
+	fprintf (f, "    \"cycles\": %u\n", _spec.n_cycles);
+	fprintf (f, "  },\n");
+	fprintf (f, "  \"dsp_us\": {\n");
+	fprintf (f, "    \"min\": %" PRId64 ",\n", n > 0 ? dsp.front () : 0);
+	fprintf (f, "    \"mean\": %.1f,\n", n > 0 ? sum / n : 0);
+	fprintf (f, "    \"p50\": %" PRId64 ",\n", PERCENTILE (50));
+	fprintf (f, "    \"p90\": %" PRId64 ",\n", PERCENTILE (90));
+	fprintf (f, "    \"p99\": %" PRId64 ",\n", PERCENTILE (99));
+	fprintf (f, "    \"p99.9\": %" PRId64 ",\n", PERCENTILE (99.9));
+	fprintf (f, "    \"max\": %" PRId64 "\n", n > 0 ? dsp.back () : 0);
+	fprintf (f, "  },\n");
+	fprintf (f, "  \"dsp_load\": {\n");
+	fprintf (f, "    \"mean\": %.2f,\n", n > 0 ? 100. * sum / n / period : 0);
+	fprintf (f, "    \"p99\": %.2f,\n", 100. * PERCENTILE (99) / period);
+	fprintf (f, "    \"max\": %.2f\n", n > 0 ? 100. * dsp.back () / period : 0);
+	fprintf (f, "  },\n");
+	fprintf (f, "  \"process_threads\": %u,\n", threads);
+	/* CPU time of all threads (process-graph, butler, ...) per process-thread, relative to wall-clock time */
+	fprintf (f, "  \"thread_utilization\": %.3f,\n", wall > 0 ? cpu / wall / threads : 0);
+	fprintf (f, "  \"realtime_factor\": %.2f,\n", wall > 0 ? n * period / wall : 0);
+	fprintf (f, "  \"overruns\": %u,\n", overruns);
+	fprintf (f, "  \"xruns\": %u\n", _session->get_xrun_count ());
+	fprintf (f, "}\n");
+
+#undef PERCENTILE
+}
+
+static std::shared_ptr<Processor>
+new_plugin (Session* s, string const& name)
+{
+	string uri = name;
+	if (uri.find (':') == string::npos && uri.compare (0, 2, "a-") == 0) {
+		/* bundled plugins, e.g. "a-comp" */
+		uri = "urn:ardour:" + uri;
+	}
+	std::shared_ptr<Processor> p = LuaAPI::new_plugin (s, uri, LV2);
+	if (!p) {
+		p = LuaAPI::new_plugin (s, name, Lua);
+	}
+	return p;
+}
+
+static void
+add_gain_automation (std::shared_ptr<Route> r, LoadSpec const& spec, uint32_t n)
+{
+	if (spec.automation <= 0) {
+		return;
+	}
+
+	std::shared_ptr<AutomationControl> ac = r->gain_control ();
+	std::shared_ptr<AutomationList>    al = ac->alist ();
+
+	const samplecnt_t len   = (spec.n_warmup + spec.n_cycles) * (samplecnt_t)spec.buffer_size;
+	const samplecnt_t step  = std::max<samplecnt_t> (1, spec.sample_rate / spec.automation);
+	const double      phase = n * .1;
+
+	al->freeze ();
+	for (samplepos_t t = 0; t <= len; t += step) {
+		/* deterministic 1Hz modulation between -6dBFS and 0dBFS */
+		double g = .75 + .25 * sin (phase + 2. * M_PI * t / (double)spec.sample_rate);
+		al->fast_simple_add (Temporal::timepos_t (t), g);
+	}
+	al->thaw ();
+	ac->set_automation_state (Play);
+}
+
+static bool
+populate_session (Session* s, LoadSpec const& spec)
+{
+	RouteList busses;
+	RouteList tracks;
+
+	if (spec.n_busses > 0) {
+		busses = s->new_audio_route (2, 2, 0, spec.n_busses, "Bus", PresentationInfo::AudioBus, PresentationInfo::max_order);
+		if (busses.size () != spec.n_busses) {
+			cerr << "Error: Cannot create busses\n";
+			return false;
+		}
+	}
+
+	if (spec.n_tracks > 0) {
+		list<std::shared_ptr<AudioTrack> > at = s->new_audio_track (1, 2, 0, spec.n_tracks, "Audio", PresentationInfo::max_order);
+		if (at.size () != spec.n_tracks) {
+			cerr << "Error: Cannot create audio tracks\n";
+			return false;
+		}
+		tracks.insert (tracks.end (), at.begin (), at.end ());
+	}
+
+	if (spec.n_midi_tracks > 0) {
+		PluginInfoPtr instrument = LuaAPI::new_plugin_info ("https://community.ardour.org/node/7596", LV2); // ACE Reasonable Synth
+		list<std::shared_ptr<MidiTrack> > mt = s->new_midi_track (ChanCount (DataType::MIDI, 1), ChanCount (DataType::AUDIO, 2), true, instrument, 0, 0, spec.n_midi_tracks, "MIDI", PresentationInfo::max_order, Normal, true);
+		if (mt.size () != spec.n_midi_tracks) {
+			cerr << "Error: Cannot create MIDI tracks\n";
+			return false;
+		}
+		tracks.insert (tracks.end (), mt.begin (), mt.end ());
+	}
+
+	uint32_t n = 0;
+	for (RouteList::const_iterator r = tracks.begin (); r != tracks.end (); ++r, ++n) {
+		/* process the generated input signal */
+		(*r)->monitoring_control ()->set_value (MonitorInput, PBD::Controllable::NoGroup);
+
+		for (vector<string>::const_iterator i = spec.plugins.begin (); i != spec.plugins.end (); ++i) {
+			std::shared_ptr<Processor> p = new_plugin (s, *i);
+			if (!p) {
+				cerr << "Error: Cannot find plugin '" << *i << "'\n";
+				return false;
+			}
+			if ((*r)->add_processor (p, PreFader, 0, true)) {
+				cerr << "Error: Cannot add plugin '" << *i << "' to " << (*r)->name () << "\n";
+				return false;
+			}
+		}
+
+		if (!busses.empty ()) {
+			RouteList::const_iterator b = busses.begin ();
+			std::advance (b, n % busses.size ());
+			for (uint32_t i = 0; i < spec.n_sends && i < busses.size (); ++i) {
+				s->add_internal_send (*b, (*r)->main_outs (), *r);
+				if (++b == busses.end ()) {
+					b = busses.begin ();
+				}
+			}
+		}
+
+		add_gain_automation (*r, spec, n);
+	}
+
+	return true;
+}
+
+static Session*
+create_load_test_session (string const& dir, LoadSpec const& spec, bool midi)
+{
+	AudioEngine* engine = AudioEngine::create ();
+
+	if (!engine->set_backend ("None (Dummy)", "Unit-Test", "")) {
+		cerr << "Cannot create Audio/MIDI engine\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	/* deterministic input signals */
+	engine->set_device_name ("Sine Wave");
+	engine->current_backend ()->set_midi_option (midi ? "Midi Event Generators" : "No MIDI I/O");
+
+	engine->set_input_channels (8);
+	engine->set_output_channels (8);
+
+	if (engine->set_sample_rate (spec.sample_rate)) {
+		cerr << "Cannot set samplerate.\n";
+		return 0;
+	}
+
+	if (engine->set_buffer_size (spec.buffer_size)) {
+		cerr << "Cannot set buffer-size.\n";
+		return 0;
+	}
+
+	if (engine->start () != 0) {
+		cerr << "Cannot start Audio/MIDI engine\n";
+		return 0;
+	}
+
+	BusProfile bus_profile;
+	bus_profile.master_out_channels = 2;
+
+	Session* session = new Session (*engine, dir, "loadtest", &bus_profile);
+	engine->set_session (session);
+	return session;
+}
+
+static void
+usage ()
+{
+	// help2man compatible format (standard GNU help-text)
+	printf (UTILNAME " - run a synthetic session and report DSP load.\n\n");
+	printf ("Usage: " UTILNAME " [ OPTIONS ]\n\n");
+	printf ("Options:\n\
+  -a, --automation <rate>    Gain automation events per second (default 0)\n\
+  -b, --busses <num>         Number of stereo busses (default 4)\n\
+  -B, --buffer-size <num>    Samples per cycle (default 256)\n\
+  -c, --cycles <num>         Number of cycles to measure (default 8192)\n\
+  -h, --help                 Display this help and exit\n\
+  -j, --threads <num>        Process threads, see processor-usage (default -1)\n\
+  -m, --midi-tracks <num>    Number of MIDI tracks with an instrument (default 0)\n\
+  -o, --output <file>        Write JSON report to file (default stdout)\n\
+  -p, --plugin <id>          Add plugin to every track, may be given multiple times\n\
+  -s, --samplerate <rate>    Samplerate to use (default 48000)\n\
+  -S, --sends <num>          Aux-sends per track (default 1)\n\
+  -t, --tracks <num>         Number of mono audio tracks (default 16)\n\
+  -T, --timeout <sec>        Abort if the test does not complete in time (default 300)\n\
+  -V, --version              Print version information and exit\n\
+  -w, --warmup <num>         Cycles to run before measuring (default 256)\n\
+\n");
+
+	printf ("\n\
+This tool creates a temporary session with the given number of tracks\n\
+and busses, and processes it using the Dummy backend in freewheel mode,\n\
+as fast as possible. The time spent in the session's process callback\n\
+is measured for every cycle, and a summary is printed as JSON.\n\
+\n\
+Input signals, plugin settings and automation are deterministic, so\n\
+results are comparable across builds on the same machine.\n\
+\n\
+Plugins are identified by URI or name. Bundled LV2 plugins can be\n\
+abbreviated, e.g. 'a-comp' for 'urn:ardour:a-comp'. If no plugin is\n\
+given, every track uses a-comp, a-eq and a-reverb.\n\
+\n\
+'overruns' is the number of cycles that took longer than the\n\
+nominal cycle period (buffer-size / samplerate).\n\
+\n\
+The exit status is non-zero, and no report is written, if the engine\n\
+stops, or the test does not complete within the given timeout.\n\
+\n");
+
+	printf ("\n\
+Examples:\n\
+" UTILNAME " -t 64 -b 8 -a 10 -p a-comp -p a-eq -o result.json\n\
+\n");
+
+	printf ("Report bugs to <https://tracker.ardour.org/>\n"
+	        "Website: <https://ardour.org/>\n");
+	::exit (EXIT_SUCCESS);
+}
+
+int
+main (int argc, char* argv[])
+{
+	LoadSpec spec;
+	string   outfile;
+
+	const char* optstring = "a:b:B:c:hj:m:o:p:s:S:t:T:Vw:";
+
+	/* clang-format off */
+	const struct option longopts[] = {
+		{ "automation",  required_argument, 0, 'a' },
+		{ "busses",      required_argument, 0, 'b' },
+		{ "buffer-size", required_argument, 0, 'B' },
+		{ "cycles",      required_argument, 0, 'c' },
+		{ "help",        no_argument,       0, 'h' },
+		{ "threads",     required_argument, 0, 'j' },
+		{ "midi-tracks", required_argument, 0, 'm' },
+		{ "output",      required_argument, 0, 'o' },
+		{ "plugin",      required_argument, 0, 'p' },
+		{ "samplerate",  required_argument, 0, 's' },
+		{ "sends",       required_argument, 0, 'S' },
+		{ "tracks",      required_argument, 0, 't' },
+		{ "timeout",     required_argument, 0, 'T' },
+		{ "version",     no_argument,       0, 'V' },
+		{ "warmup",      required_argument, 0, 'w' },
+		{ 0, 0, 0, 0 }
+	};
+	/* clang-format on */
+
+	int c = 0;
+	while (EOF != (c = getopt_long (argc, argv,
+	                                optstring, longopts, (int*)0))) {
+		switch (c) {
+			case 'a':
+				spec.automation = atof (optarg);
+				break;
+			case 'b':
+				spec.n_busses = atoi (optarg);
+				break;
+			case 'B': {
+				const int bs = atoi (optarg);
+				if (bs >= 16 && bs <= 8192) {
+					spec.buffer_size = bs;
+				} else {
+					cerr << "Invalid buffer-size\n";
+				}
+			} break;
+			case 'c':
+				spec.n_cycles = std::max (1, atoi (optarg));
+				break;
+			case 'j':
+				spec.n_threads = atoi (optarg);
+				break;
+			case 'm':
+				spec.n_midi_tracks = atoi (optarg);
+				break;
+			case 'o':
+				outfile = optarg;
+				break;
+			case 'p':
+				spec.plugins.push_back (optarg);
+				break;
+			case 's': {
+				const int sr = atoi (optarg);
+				if (sr >= 8000 && sr <= 192000) {
+					spec.sample_rate = sr;
+				} else {
+					cerr << "Invalid Samplerate\n";
+				}
+			} break;
+			case 'S':
+				spec.n_sends = atoi (optarg);
+				break;
+			case 't':
+				spec.n_tracks = atoi (optarg);
+				break;
+			case 'T':
+				spec.timeout = std::max (1, atoi (optarg));
+				break;
+			case 'w':
+				spec.n_warmup = atoi (optarg);
+				break;
+
+			case 'V':
+				printf ("ardour-utils version %s\n\n", VERSIONSTRING);
+				printf ("Copyright (C) GPL 2024\n");
+				exit (EXIT_SUCCESS);
+				break;
+
+			case 'h':
+				usage ();
+				break;
+
+			default:
+				cerr << "Error: unrecognized option. See --help for usage information.\n";
+				::exit (EXIT_FAILURE);
+				break;
+		}
+	}
+
+	if (optind != argc) {
+		cerr << "Error: Extra parameter given. See --help for usage information.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	if (spec.plugins.empty ()) {
+		spec.plugins.push_back ("a-comp");
+		spec.plugins.push_back ("a-eq");
+		spec.plugins.push_back ("a-reverb");
+	}
+
+	FILE* f = stdout;
+	if (!outfile.empty ()) {
+		f = g_fopen (outfile.c_str (), "w");
+		if (!f) {
+			cerr << "Error: Cannot open output file '" << outfile << "'\n";
+			::exit (EXIT_FAILURE);
+		}
+	}
+
+	/* all systems go */
+
+	/* log messages are printed to stdout, along with the report */
+	SessionUtils::init (!outfile.empty ());
+	Config->set_processor_usage (spec.n_threads);
+
+	string   dir = PBD::tmp_writable_directory (PACKAGE, "loadtest");
+	Session* s   = 0;
+	int      rv  = EXIT_FAILURE;
+
+	try {
+		s = create_load_test_session (dir, spec, spec.n_midi_tracks > 0);
+	} catch (ARDOUR::SessionException& e) {
+		cerr << "Error: " << e.what () << "\n";
+	} catch (...) {
+		cerr << "Error: unknown exception.\n";
+	}
+
+	if (s && populate_session (s, spec)) {
+		LoadTest lt (s, spec);
+		s->request_roll ();
+		if (lt.run ()) {
+			lt.report (f);
+			rv = EXIT_SUCCESS;
+		}
+	}
+
+	if (f != stdout) {
+		fclose (f);
+	}
+
+	SessionUtils::unload_session (s);
+	SessionUtils::cleanup ();
+
+	PBD::remove_directory (dir);
+
+	return rv;
+}